@@ -14,22 +14,42 @@ local sortedModsResources  = {
 }
 
 local mods = {}
+local modsScanGeneration
 
 local output = {}
 
-local function getModsResourceName(filePath)
+local isKnowledgeBaseIndexed = false
+local logPageSize = 10000
+
+local function indexKnowledgeBase()
+    if isKnowledgeBaseIndexed then return end
+
     local modsResources = require("knowledgeBase/modsResources")
-    local modsResourcesTable = modsResources.getTable()
 
-    filePath = utils.normalizePath(filePath)
+    for name, relativePath in pairs(modsResources.getTable()) do
+        GameDiagnostics.AddKnowledgeBasePath(name, relativePath)
+    end
 
-    for name, relativePath in pairs(modsResourcesTable) do
-        if string.find(filePath, "%" .. relativePath:lower() .. "$") then
-            return name
+    isKnowledgeBaseIndexed = true
+end
+
+local function getModsResourceNames(filePaths)
+    indexKnowledgeBase()
+
+    local names = GameDiagnostics.IdentifyPaths(filePaths)
+    local result = {}
+
+    for i = 1, #filePaths do
+        if names[i] and names[i] ~= "" then
+            result[i] = names[i]
         end
     end
 
-    return nil
+    return result
+end
+
+local function getModsResourceName(filePath)
+    return getModsResourceNames({ filePath })[1]
 end
 
 local function ensureIsVersion(filePath, version)
@@ -42,85 +62,45 @@ local function ensureIsVersion(filePath, version)
     return version
 end
 
-local function isIgnoredFile(fileName, includeLogs)
-    fileName = string.lower(fileName)
-
-    local ignoredFiles = {
-        [".stub"] = true,
-        ["__folder_managed_by_vortex"] = true,
-        ["db.sqlite3"] = true,
-        ["vortex_placeholder.txt"] = true,
-        ["vortexdeployment.json"] = true,
+-- Handed to Walk as exclude globs, so ignored directories are pruned instead of walked and filtered afterwards.
+local function getIgnoredGlobs(includeLogs)
+    local ignoredGlobs = {
+        "**/.stub",
+        "**/__folder_managed_by_vortex",
+        "**/db.sqlite3",
+        "**/vortex_placeholder.txt",
+        "**/vortexdeployment.json",
+        "**/*.vortex_backup",
     }
 
-    if ignoredFiles[fileName] or string.find(fileName, "%.vortex_backup$") then
-        return true
-    end
-
-    if not includeLogs and string.find(fileName, "%.log$") then
-        return true
+    if not includeLogs then
+        table.insert(ignoredGlobs, "**/*.log")
     end
 
-    return false
+    return ignoredGlobs
 end
 
-local function mapDirectory(relativePath, includeLogs)
+local function getPaths(relativePath, includeLogs, include)
     relativePath = utils.normalizePath(relativePath)
-    local items = GameDiagnostics.ListDirectory(relativePath)
+    local options = GameDiagnosticsWalkOptions.new()
+    options.filesOnly = true
+    options.parallel = true
+    options.exclude = getIgnoredGlobs(includeLogs)
 
-    if not items then
-        return nil
+    if include then
+        options.include = include
     end
 
+    local entries = GameDiagnostics.Walk(relativePath, options)
     local result = {}
 
-    for _, item in ipairs(items) do
-        if not isIgnoredFile(item.name, includeLogs) then
-            if item.type == "file" then
-                result[item.name] = {
-                    type = "file"
-                }
-            elseif item.type == "dir" then
-                local subPath
-
-                if relativePath == "" then
-                    subPath = item.name
-                else
-                    subPath = relativePath .. "/" .. item.name
-                end
-
-                result[item.name] = {
-                    type = "dir",
-                    contents = mapDirectory(subPath, includeLogs)
-                }
-            end
-        end
+    for _, entry in ipairs(entries) do
+        table.insert(result, entry.path)
     end
 
     return result
 end
 
-local function getPaths(dirMap, currentPath, result)
-    result = result or {}
-    currentPath = currentPath or ""
-
-    for name, item in pairs(dirMap) do
-        local path = currentPath == "" and name or currentPath .. "/" .. name
-
-        if item.type == "file" then
-            table.insert(result, path)
-        elseif item.type == "dir" and item.contents then
-            getPaths(item.contents, path, result)
-        end
-    end
-
-    if currentPath == "" then
-        table.sort(result)
-
-        return result
-    end
-end
-
 local function getHashes()
 
 end
@@ -128,8 +108,8 @@ end
 local function generatePaths(location, includeLogs, stageBaseDirectory)
     local gamePath = GameDiagnostics.GetGamePath()
     location = utils.removePrefixPath(location, gamePath)
-    local result = getPaths(mapDirectory(location, includeLogs))
-    local pathsString = ""
+    local result = getPaths(location, includeLogs)
+    local lines = {}
 
     for i, line in ipairs(result) do
         if stageBaseDirectory then
@@ -137,17 +117,43 @@ local function generatePaths(location, includeLogs, stageBaseDirectory)
         end
 
         if location ~= "" and not stageBaseDirectory then
-            pathsString = pathsString .. location .. "/" .. line
+            lines[i] = location .. "/" .. line
         else
-            pathsString = pathsString .. line
+            lines[i] = line
         end
+    end
 
-        if i < #result then
-            pathsString = pathsString .. "\n"
+    return table.concat(lines, "\n")
+end
+
+local function applyArchiveIndexes(regularItems, archiveIndexes)
+    for i, item in ipairs(regularItems) do
+        if archiveIndexes[i] then
+            item.isValidArchive = archiveIndexes[i].isValid
+            item.resourceCount = archiveIndexes[i].fileCount
         end
     end
+end
+
+local function pollArchiveIndexes(regularItems)
+    local query = Game.GetCyberlibsAsyncHelper():GetArchiveIndexes()
+
+    if query.isCalculating then
+        utils.setDelay(0.1, "pollArchiveIndexes", pollArchiveIndexes, regularItems)
+    else
+        applyArchiveIndexes(regularItems, query.archives)
+    end
+end
 
-    return pathsString
+local function readArchiveIndexes(regularItems, regularPaths)
+    local asyncHelper = Game.GetCyberlibsAsyncHelper()
+
+    if asyncHelper then
+        asyncHelper:ReadArchiveIndexes(regularPaths)
+        pollArchiveIndexes(regularItems)
+    else
+        applyArchiveIndexes(regularItems, GameDiagnostics.ReadArchiveIndexes(regularPaths))
+    end
 end
 
 local function scanArchiveMods()
@@ -160,6 +166,7 @@ local function scanArchiveMods()
     local archivePath = "archive/pc/mod"
     local archiveDir = GameDiagnostics.ListDirectory(archivePath)
     local archives = {}
+    local regularItems = {}
 
     for _, item in ipairs(archiveDir) do
         if item.type == "file" then
@@ -181,12 +188,7 @@ local function scanArchiveMods()
                 if isXl then
                     archives[baseName].xl = item
                 else
-                    local kbName = getModsResourceName(item.normalizedPath)
-
-                    if kbName then
-                        table.insert(item.tags, "mods resource")
-                        item.kbName = kbName
-                    end
+                    table.insert(regularItems, item)
 
                     archives[baseName].regular = item
                 end
@@ -194,6 +196,23 @@ local function scanArchiveMods()
         end
     end
 
+    local regularPaths = {}
+
+    for i, item in ipairs(regularItems) do
+        regularPaths[i] = item.normalizedPath
+    end
+
+    local kbNames = getModsResourceNames(regularPaths)
+
+    for i, item in ipairs(regularItems) do
+        if kbNames[i] then
+            table.insert(item.tags, "mods resource")
+            item.kbName = kbNames[i]
+        end
+    end
+
+    readArchiveIndexes(regularItems, regularPaths)
+
     for baseName, files in pairs(archives) do
         if files.regular and files.xl then
             table.insert(files.regular.tags, "archive")
@@ -210,18 +229,9 @@ local function scanArchiveMods()
 end
 
 local function getPathsFile(modDirPath)
-    local files = getPaths(mapDirectory(modDirPath, false))
-    local pathsFile = nil
-
-    for _, filePath in ipairs(files) do
-        if string.find(filePath, "%.paths$") then
-            pathsFile = filePath
+    local files = getPaths(modDirPath, false, { "**/*.paths" })
 
-            break
-        end
-    end
-
-    return pathsFile
+    return files[1]
 end
 
 local function scanCetMods()
@@ -235,6 +245,9 @@ local function scanCetMods()
     local cetPath = "bin/x64/plugins/cyber_engine_tweaks/mods"
     local cetDir = GameDiagnostics.ListDirectory(cetPath)
 
+    local modDirs = {}
+    local initPaths = {}
+
     for _, item in ipairs(cetDir) do
         if item.type == "dir" then
             item.tags = { "cet" }
@@ -245,19 +258,24 @@ local function scanCetMods()
                 item.pathsFile = pathsFile
             end
 
-            local initPath = item.normalizedPath .. "/init.lua"
-            local kbName = getModsResourceName(initPath)
+            table.insert(modDirs, item)
+            table.insert(initPaths, item.normalizedPath .. "/init.lua")
+        end
+    end
 
-            if kbName then
-                table.insert(item.tags, "mods resource")
-                item.kbName = kbName
-            end
+    local kbNames = getModsResourceNames(initPaths)
+    local initStats = GameDiagnostics.StatBatch(initPaths)
 
-            if GameDiagnostics.IsFile(initPath) then
-                table.insert(mods.cet.enabled, item)
-            else
-                table.insert(mods.cet.disabled, item)
-            end
+    for i, item in ipairs(modDirs) do
+        if kbNames[i] then
+            table.insert(item.tags, "mods resource")
+            item.kbName = kbNames[i]
+        end
+
+        if initStats[i] and initStats[i].type == "file" then
+            table.insert(mods.cet.enabled, item)
+        else
+            table.insert(mods.cet.disabled, item)
         end
     end
 end
@@ -392,12 +410,12 @@ local function scanRedscriptMods()
                         item.pathsFile = pathsFile
                     end
 
-                    for _, scriptPath in ipairs(scriptPaths) do
-                        local kbName = getModsResourceName(scriptPath)
+                    local kbNames = getModsResourceNames(scriptPaths)
 
-                        if kbName then
+                    for i = 1, #scriptPaths do
+                        if kbNames[i] then
                             table.insert(item.tags, "mods resource")
-                            item.kbName = kbName
+                            item.kbName = kbNames[i]
 
                             break
                         end
@@ -542,10 +560,37 @@ local function sortModsResources(t)
     end
 end
 
+local function haveModsChanged()
+    if not modsScanGeneration then return false end
+
+    local modsDirectories = {
+        "archive/pc/mod",
+        "bin/x64/plugins/cyber_engine_tweaks/mods",
+        "red4ext/plugins",
+        "r6/scripts",
+        "r6/tweaks",
+    }
+
+    for _, path in ipairs(modsDirectories) do
+        if GameDiagnostics.HasChangedSince(path, modsScanGeneration) then
+            return true
+        end
+    end
+
+    return false
+end
+
 local function scanMods()
     ImGuiExt.SetNotification(0, "Scanning mods, please wait...")
 
+    if haveModsChanged() then
+        mods = {}
+        sortedModsResources.parsed = {}
+    end
+
     if not next(mods) then
+        modsScanGeneration = GameDiagnostics.GetTreeGeneration()
+
         scanArchiveMods()
         scanCetMods()
         scanRed4extMods()
@@ -581,6 +626,23 @@ local function isModsReport(fileName)
     end
 end
 
+local function readLog(relativeFilePath)
+    local lines = {}
+    local lineCount = GameDiagnostics.GetLineCount(relativeFilePath)
+
+    if lineCount < 0 then
+        return "Failed to read file"
+    end
+
+    for start = 0, lineCount - 1, logPageSize do
+        for _, line in ipairs(GameDiagnostics.ReadLines(relativeFilePath, start, logPageSize)) do
+            table.insert(lines, line)
+        end
+    end
+
+    return table.concat(lines, "\n")
+end
+
 local function getModsReport()
     local reportsDir = "_REPORTS"
     local fileName = "Mods-" .. GameDiagnostics.GetCurrentTimeDate(true) .. ".txt"
@@ -638,31 +700,17 @@ local function getModsReport()
         text = text ..  "\n\n\n" .. style.formatHeader("RED4ext Current Log")
 
         local red4extLogsPath = "red4ext/logs"
-        local red4extDir = GameDiagnostics.ListDirectory(red4extLogsPath)
-        local red4extLogs = {}
-        local red4extLog
-
-        for i, item in ipairs(red4extDir) do
-            if item.type == "file" and string.find(item.name, "^red4ext")then
-                item.date = GameDiagnostics.GetTimeDateStamp(red4extLogsPath .. "/" .. item.name, true)
+        local red4extDir = GameDiagnostics.ListDirectory(red4extLogsPath, "lastWriteTime", true)
+        local red4extLog = ""
 
-                table.insert(red4extLogs, item)
-            end
-        end
+        for _, item in ipairs(red4extDir) do
+            if item.type == "file" and string.find(item.name, "^red4ext") then
+                red4extLog = readLog(red4extLogsPath .. "/" .. item.name)
 
-        local lastDate = red4extLogs[1].date
-        local lastLog = red4extLogs[1]
-
-        for i = 2, #red4extLogs do
-            local currentDate = red4extLogs[i].date
-
-            if utils.compareTimeDateStamps(currentDate, lastDate) then
-                lastDate = red4extLogs[i].date
-                lastLog = red4extLogs[i]
+                break
             end
         end
 
-        red4extLog = GameDiagnostics.ReadTextFile(red4extLogsPath .. "/" .. lastLog.name)
         text = text .. "\n\n" .. red4extLog
         text = text .. "\n" .. style.formatFooter()
     end
@@ -690,7 +738,7 @@ local function getModsReport()
     if output.mods.inculdeCurrentLogs then
         text = text ..  "\n\n\n" .. style.formatHeader("RedScript Current Log")
 
-        local redscriptLog = GameDiagnostics.ReadTextFile("r6/logs/redscript_rCURRENT.log")
+        local redscriptLog = readLog("r6/logs/redscript_rCURRENT.log")
 
         text = text .. "\n\n" .. redscriptLog
         text = text .. "\n" .. style.formatFooter()
@@ -719,6 +767,12 @@ local function getModsReport()
     for _, mod in ipairs(mods.archive.enabled) do
         text = text .. "\n" .. style.formatEntry(mod.name)
 
+        if mod.isValidArchive == false then
+            text = text .. " (unreadable archive index)"
+        elseif mod.resourceCount then
+            text = text .. " (" .. tostring(mod.resourceCount) .. " resources)"
+        end
+
         for _, tag in ipairs(mod.tags) do
             if tag == "archiveXl" then
                 text = text .. " (found a corresponding \".xl\" file)"
@@ -769,9 +823,26 @@ local function getModsReport()
 
     text = text .. "\n" .. style.formatFooter(otherAmount)
 
+    if GameDiagnostics.HasInstallState() then
+        text = text ..  "\n\n\n" .. style.formatHeader("Changes Since Last Session")
+
+        local changes = GameDiagnostics.DiffInstallState()
+
+        for _, change in ipairs(changes) do
+            text = text .. "\n" .. style.formatEntry(change.path ..
+                                                        utils.setStringCursor(change.path, 108, " ") ..
+                                                        change.change)
+        end
+
+        text = text .. "\n" .. style.formatFooter(#changes)
+    end
+
     text = text .. "\n\nEnd of Report."
 
-    GameDiagnostics.WriteToOutput(filePath, text)
+    -- Writes are queued; flushing makes sure the report is on disk before isModsReport looks for it.
+    if not GameDiagnostics.WriteToOutput(filePath, text) or not GameDiagnostics.FlushOutput() then
+        return
+    end
 
     return fileName
 end
@@ -890,8 +961,11 @@ local function dumpPaths(requestedLocations, includeLogs, asPaths, stageBaseDire
         end
     end
 
-    GameDiagnostics.WriteToOutput(filePath, result)
-    ImGuiExt.SetNotification(2, "Requested paths are ready.")
+    if GameDiagnostics.WriteToOutput(filePath, result) and GameDiagnostics.FlushOutput() then
+        ImGuiExt.SetNotification(2, "Requested paths are ready.")
+    else
+        ImGuiExt.SetNotification(2, "Couldn't write requested paths.")
+    end
 end
 
 local function drawGetPathsConfirmation(nonStandardLocations)
@@ -1214,6 +1288,12 @@ end
 function events.onOverlayClose()
     output.paths.isConfirmationPopup = false
     output.paths.isInvalidLocationsPopup = false
+
+    local asyncHelper = Game.GetCyberlibsAsyncHelper()
+
+    if asyncHelper then
+        asyncHelper:CancelAll()
+    end
 end
 
 local function getFileHashAsync(filePath)
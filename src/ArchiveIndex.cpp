@@ -0,0 +1,129 @@
+#include "ArchiveIndex.hpp"
+#include "MappedFile.hpp"
+#include "WorkStealingPool.hpp"
+
+void CyberlibsCore::ArchiveIndex::Read(const std::filesystem::path& path, bool includeResources, Summary& summary)
+{
+    summary = Summary{};
+
+    MappedFile file;
+    uint64_t indexPosition = 0;
+    uint32_t indexSize = 0;
+    if (!file.OpenForRanges(path) ||
+        !parseHeader(file.MapRange(0, HEADER_SIZE), file.Size(), summary, indexPosition, indexSize) ||
+        !parseIndex(file.MapRange(indexPosition, indexSize), includeResources, summary))
+    {
+        summary = Summary{};
+        return;
+    }
+
+    summary.isValid = true;
+}
+
+void CyberlibsCore::ArchiveIndex::ReadMany(const std::vector<std::filesystem::path>& paths, bool includeResources,
+                                           uint32_t maxThreads, std::vector<Summary>& summaries,
+                                           DiagnosticsJob* job)
+{
+    summaries.assign(paths.size(), Summary{});
+    if (job)
+    {
+        job->SetTotals(0, static_cast<uint32_t>(paths.size()));
+    }
+
+    WorkStealingPool::Run(paths.size(), maxThreads,
+                          [&](size_t index)
+                          {
+                              if (job && job->IsCancelled())
+                              {
+                                  return;
+                              }
+
+                              Read(paths[index], includeResources, summaries[index]);
+                              if (job)
+                              {
+                                  job->AddFiles(1);
+                              }
+                          });
+}
+
+// Private Helpers
+
+bool CyberlibsCore::ArchiveIndex::parseHeader(std::string_view header, uint64_t fileSize, Summary& summary,
+                                              uint64_t& indexPosition, uint32_t& indexSize)
+{
+    // Header: magic, version, index position (u64), index size, debug position (u64), debug size, file size (u64).
+    if (header.size() < HEADER_SIZE || load<uint32_t>(header.data()) != MAGIC)
+    {
+        return false;
+    }
+
+    summary.version = load<uint32_t>(header.data() + 4);
+    indexPosition = load<uint64_t>(header.data() + 8);
+    indexSize = load<uint32_t>(header.data() + 16);
+
+    return indexPosition <= fileSize && indexSize <= fileSize - indexPosition && indexSize >= INDEX_HEADER_SIZE;
+}
+
+bool CyberlibsCore::ArchiveIndex::parseIndex(std::string_view view, bool includeResources, Summary& summary)
+{
+    if (view.size() < INDEX_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    // Index header: file table offset, file table size, CRC (u64), then the three counts. The file entries, the
+    // segments and the dependency hashes follow back to back.
+    const char* index = view.data();
+    summary.fileCount = load<uint32_t>(index + 16);
+    summary.segmentCount = load<uint32_t>(index + 20);
+    summary.dependencyCount = load<uint32_t>(index + 24);
+
+    uint64_t tableSize = INDEX_HEADER_SIZE + static_cast<uint64_t>(summary.fileCount) * FILE_ENTRY_SIZE +
+                         static_cast<uint64_t>(summary.segmentCount) * SEGMENT_SIZE +
+                         static_cast<uint64_t>(summary.dependencyCount) * DEPENDENCY_SIZE;
+    if (tableSize > view.size())
+    {
+        return false;
+    }
+
+    const char* entries = index + INDEX_HEADER_SIZE;
+    const char* segments = entries + static_cast<size_t>(summary.fileCount) * FILE_ENTRY_SIZE;
+
+    // Segment: payload offset (u64), compressed size, size.
+    for (uint32_t i = 0; i < summary.segmentCount; ++i)
+    {
+        const char* segment = segments + static_cast<size_t>(i) * SEGMENT_SIZE;
+        summary.compressedSize += load<uint32_t>(segment + 8);
+        summary.size += load<uint32_t>(segment + 12);
+    }
+
+    if (!includeResources)
+    {
+        return true;
+    }
+
+    // File entry: hash (u64), timestamp (u64), inline buffer count, segment range, dependency range, SHA-1.
+    summary.resources.reserve(summary.fileCount);
+    for (uint32_t i = 0; i < summary.fileCount; ++i)
+    {
+        const char* entry = entries + static_cast<size_t>(i) * FILE_ENTRY_SIZE;
+        uint32_t segmentsStart = load<uint32_t>(entry + 20);
+        uint32_t segmentsEnd = load<uint32_t>(entry + 24);
+        if (segmentsStart > segmentsEnd || segmentsEnd > summary.segmentCount)
+        {
+            return false;
+        }
+
+        Resource resource{load<uint64_t>(entry), 0, 0};
+        for (uint32_t j = segmentsStart; j < segmentsEnd; ++j)
+        {
+            const char* segment = segments + static_cast<size_t>(j) * SEGMENT_SIZE;
+            resource.compressedSize += load<uint32_t>(segment + 8);
+            resource.size += load<uint32_t>(segment + 12);
+        }
+
+        summary.resources.push_back(resource);
+    }
+
+    return true;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "DiagnosticsJobs.hpp"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Reads the index of a game .archive (RDAR) without touching its payload. Only the 40-byte header and the index it
+// points at are mapped, one after the other, so the payload is never read from disk, however large the archive is.
+class ArchiveIndex
+{
+public:
+    // "RDAR" read as a little-endian integer.
+    static constexpr uint32_t MAGIC = 0x52414452;
+
+    struct Resource
+    {
+        uint64_t hash;
+        // Sums over the resource's segments: the main buffer plus its inline buffers.
+        uint64_t size;
+        uint64_t compressedSize;
+    };
+
+    struct Summary
+    {
+        bool isValid;
+        uint32_t version;
+        uint32_t fileCount;
+        uint32_t segmentCount;
+        uint32_t dependencyCount;
+        uint64_t size;
+        uint64_t compressedSize;
+        // Only filled when asked for, in file table order.
+        std::vector<Resource> resources;
+    };
+
+    // isValid is false for files that cannot be mapped, are not archives or have an index that does not fit.
+    static void Read(const std::filesystem::path& path, bool includeResources, Summary& summary);
+    // summaries[i] describes paths[i]. Archives are read in parallel. job, if given, counts each archive read and
+    // stops the rest once cancelled.
+    static void ReadMany(const std::vector<std::filesystem::path>& paths, bool includeResources, uint32_t maxThreads,
+                         std::vector<Summary>& summaries, DiagnosticsJob* job = nullptr);
+
+private:
+    static constexpr size_t HEADER_SIZE = 40;
+    static constexpr size_t INDEX_HEADER_SIZE = 28;
+    static constexpr size_t FILE_ENTRY_SIZE = 56;
+    static constexpr size_t SEGMENT_SIZE = 16;
+    static constexpr size_t DEPENDENCY_SIZE = 8;
+
+    static bool parseHeader(std::string_view header, uint64_t fileSize, Summary& summary, uint64_t& indexPosition,
+                            uint32_t& indexSize);
+    static bool parseIndex(std::string_view index, bool includeResources, Summary& summary);
+
+    template<typename T>
+    static T load(const char* data)
+    {
+        T value;
+        std::memcpy(&value, data, sizeof(T));
+
+        return value;
+    }
+};
+} // namespace CyberlibsCore
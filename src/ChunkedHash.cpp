@@ -0,0 +1,402 @@
+#include "ChunkedHash.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <memory>
+
+CyberlibsCore::FileReader::Status CyberlibsCore::ChunkedHash::Build(const std::filesystem::path& path,
+                                                                    uint64_t chunkSize, uint32_t maxThreads,
+                                                                    const FileReader::Options& readOptions,
+                                                                    Manifest& manifest)
+{
+    std::error_code ec;
+    uint64_t fileSize = std::filesystem::file_size(path, ec);
+    if (ec || chunkSize == 0)
+    {
+        return FileReader::Status::OpenFailed;
+    }
+
+    std::vector<uint64_t> indices(chunkCount(fileSize, chunkSize));
+    for (uint64_t i = 0; i < indices.size(); ++i)
+    {
+        indices[i] = i;
+    }
+
+    manifest.fileSize = fileSize;
+    manifest.chunkSize = chunkSize;
+    manifest.chunks.assign(indices.size(), Digest{});
+
+    auto status = hashChunks(path, chunkSize, indices, maxThreads, readOptions, manifest.chunks);
+    if (status != FileReader::Status::Ok)
+    {
+        return status;
+    }
+
+    manifest.root = ComputeRoot(manifest.chunks);
+
+    return FileReader::Status::Ok;
+}
+
+CyberlibsCore::FileReader::Status CyberlibsCore::ChunkedHash::Verify(const std::filesystem::path& path,
+                                                                     const Manifest& manifest,
+                                                                     const std::vector<ByteRange>& changedRanges,
+                                                                     uint32_t maxThreads,
+                                                                     const FileReader::Options& readOptions,
+                                                                     VerifyResult& result)
+{
+    std::error_code ec;
+    uint64_t fileSize = std::filesystem::file_size(path, ec);
+    if (ec || manifest.chunkSize == 0)
+    {
+        return FileReader::Status::OpenFailed;
+    }
+
+    const uint64_t chunkSize = manifest.chunkSize;
+    const uint64_t count = chunkCount(fileSize, chunkSize);
+    const uint64_t expectedCount = manifest.chunks.size();
+
+    std::vector<bool> selected(count, changedRanges.empty());
+    for (const auto& range : changedRanges)
+    {
+        if (range.size == 0 || range.offset >= fileSize)
+        {
+            continue;
+        }
+
+        // Compared without forming offset + size, which can wrap for ranges coming from scripts.
+        uint64_t last = range.size > fileSize - range.offset ? fileSize - 1 : range.offset + range.size - 1;
+        for (uint64_t i = range.offset / chunkSize; i <= last / chunkSize; ++i)
+        {
+            selected[i] = true;
+        }
+    }
+
+    // A size change always touches the old tail chunk, and chunks past the manifest have no digest to reuse.
+    if (fileSize != manifest.fileSize)
+    {
+        uint64_t tail = (std::min)(count, expectedCount);
+        for (uint64_t i = tail > 0 ? tail - 1 : 0; i < count; ++i)
+        {
+            selected[i] = true;
+        }
+    }
+
+    std::vector<uint64_t> indices;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+        if (selected[i])
+        {
+            indices.push_back(i);
+        }
+    }
+
+    std::vector<Digest> chunks(manifest.chunks);
+    chunks.resize(count);
+
+    auto status = hashChunks(path, chunkSize, indices, maxThreads, readOptions, chunks);
+    if (status != FileReader::Status::Ok)
+    {
+        return status;
+    }
+
+    result.root = ComputeRoot(chunks);
+    result.mismatches.clear();
+
+    auto addMismatch = [&result](uint64_t begin, uint64_t end)
+    {
+        if (end <= begin)
+        {
+            return;
+        }
+
+        if (!result.mismatches.empty())
+        {
+            auto& previous = result.mismatches.back();
+            if (previous.offset + previous.size == begin)
+            {
+                previous.size += end - begin;
+                return;
+            }
+        }
+
+        result.mismatches.push_back({begin, end - begin});
+    };
+
+    for (uint64_t i : indices)
+    {
+        if (i >= expectedCount || chunks[i] != manifest.chunks[i])
+        {
+            addMismatch(i * chunkSize, (std::min)((i + 1) * chunkSize, fileSize));
+        }
+    }
+
+    addMismatch(fileSize, manifest.fileSize);
+
+    return FileReader::Status::Ok;
+}
+
+CyberlibsCore::ChunkedHash::Digest CyberlibsCore::ChunkedHash::ComputeRoot(const std::vector<Digest>& chunks)
+{
+    if (chunks.empty())
+    {
+        return Digest{};
+    }
+
+    std::vector<Digest> level(chunks);
+    while (level.size() > 1)
+    {
+        std::vector<Digest> next;
+        next.reserve((level.size() + 1) / 2);
+
+        for (size_t i = 0; i < level.size(); i += 2)
+        {
+            if (i + 1 == level.size())
+            {
+                next.push_back(level[i]);
+                continue;
+            }
+
+            const uint8_t prefix = 0x01;
+            struct sha256_buff sha_buff;
+            sha256_init(&sha_buff);
+            sha256_update(&sha_buff, &prefix, 1);
+            sha256_update(&sha_buff, level[i].data(), level[i].size());
+            sha256_update(&sha_buff, level[i + 1].data(), level[i + 1].size());
+            sha256_finalize(&sha_buff);
+
+            Digest node;
+            sha256_read(&sha_buff, node.data());
+            next.push_back(node);
+        }
+
+        level = std::move(next);
+    }
+
+    return level.front();
+}
+
+std::string CyberlibsCore::ChunkedHash::ToHex(const Digest& digest)
+{
+    static const char* const lut = "0123456789abcdef";
+    std::string hex(digest.size() * 2, '0');
+    for (size_t i = 0; i < digest.size(); ++i)
+    {
+        hex[i * 2] = lut[digest[i] >> 4];
+        hex[i * 2 + 1] = lut[digest[i] & 15];
+    }
+
+    return hex;
+}
+
+std::string CyberlibsCore::ChunkedHash::Serialize(const Manifest& manifest)
+{
+    std::string text = "# Cyberlibs chunk manifest\n";
+    text += "size | " + std::to_string(manifest.fileSize) + "\n";
+    text += "chunk | " + std::to_string(manifest.chunkSize) + "\n";
+    text += "root | " + ToHex(manifest.root) + "\n";
+
+    for (const auto& chunk : manifest.chunks)
+    {
+        text += ToHex(chunk) + "\n";
+    }
+
+    return text;
+}
+
+bool CyberlibsCore::ChunkedHash::Parse(std::string_view text, Manifest& manifest)
+{
+    manifest = Manifest{};
+    bool hasSize = false;
+    bool hasChunkSize = false;
+    bool hasRoot = false;
+
+    while (!text.empty())
+    {
+        size_t newline = text.find('\n');
+        std::string_view line = trim(text.substr(0, newline));
+        text = newline == std::string_view::npos ? std::string_view() : text.substr(newline + 1);
+
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        size_t pipePos = line.find('|');
+        if (pipePos == std::string_view::npos)
+        {
+            Digest chunk;
+            if (!fromHex(line, chunk))
+            {
+                return false;
+            }
+
+            manifest.chunks.push_back(chunk);
+            continue;
+        }
+
+        std::string_view key = trim(line.substr(0, pipePos));
+        std::string_view value = trim(line.substr(pipePos + 1));
+
+        if (key == "root")
+        {
+            hasRoot = fromHex(value, manifest.root);
+            continue;
+        }
+
+        uint64_t number = 0;
+        auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), number);
+        if (error != std::errc() || end != value.data() + value.size())
+        {
+            return false;
+        }
+
+        if (key == "size")
+        {
+            manifest.fileSize = number;
+            hasSize = true;
+        }
+        else if (key == "chunk")
+        {
+            manifest.chunkSize = number;
+            hasChunkSize = number > 0;
+        }
+    }
+
+    return hasSize && hasChunkSize && hasRoot &&
+           manifest.chunks.size() == chunkCount(manifest.fileSize, manifest.chunkSize) &&
+           ComputeRoot(manifest.chunks) == manifest.root;
+}
+
+// Private Helpers
+
+uint64_t CyberlibsCore::ChunkedHash::chunkCount(uint64_t fileSize, uint64_t chunkSize)
+{
+    // An empty file still has one (empty) chunk, so every manifest has a well-defined root.
+    return (std::max)((fileSize + chunkSize - 1) / chunkSize, static_cast<uint64_t>(1));
+}
+
+CyberlibsCore::FileReader::Status CyberlibsCore::ChunkedHash::hashChunks(const std::filesystem::path& path,
+                                                                         uint64_t chunkSize,
+                                                                         const std::vector<uint64_t>& indices,
+                                                                         uint32_t maxThreads,
+                                                                         const FileReader::Options& readOptions,
+                                                                         std::vector<Digest>& chunks)
+{
+    std::atomic<FileReader::Status> failure{FileReader::Status::Ok};
+    // Raised by the first failing chunk, so chunks still being read on other threads give up at their next block.
+    std::atomic<bool> aborted{false};
+
+    if (readOptions.job)
+    {
+        uint64_t fileSize = chunks.size() * chunkSize;
+        std::error_code ec;
+        fileSize = (std::min)(fileSize, static_cast<uint64_t>(std::filesystem::file_size(path, ec)));
+
+        uint64_t totalBytes = 0;
+        for (uint64_t index : indices)
+        {
+            uint64_t begin = index * chunkSize;
+            totalBytes += begin < fileSize ? (std::min)(chunkSize, fileSize - begin) : 0;
+        }
+
+        readOptions.job->SetTotals(totalBytes, 0);
+    }
+
+    // One handle serves every chunk; each read carries its own offset, so the workers can share it.
+    HANDLE file = FileReader::Open(path, readOptions);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return FileReader::Status::OpenFailed;
+    }
+
+    std::unique_ptr<void, decltype(&CloseHandle)> fileGuard(file, CloseHandle);
+
+    WorkStealingPool::Run(indices.size(), maxThreads,
+                          [&](size_t task)
+                          {
+                              if (aborted.load(std::memory_order_relaxed))
+                              {
+                                  return;
+                              }
+
+                              uint64_t index = indices[task];
+                              FileReader::Options chunkOptions = readOptions;
+                              chunkOptions.offset = index * chunkSize;
+                              chunkOptions.length = chunkSize;
+                              chunkOptions.abort = &aborted;
+
+                              const uint8_t prefix = 0x00;
+                              struct sha256_buff sha_buff;
+                              sha256_init(&sha_buff);
+                              sha256_update(&sha_buff, &prefix, 1);
+
+                              auto status = FileReader::Stream(file, chunkOptions,
+                                                               [&sha_buff](const uint8_t* data, size_t size) -> bool
+                                                               {
+                                                                   sha256_update(&sha_buff, data, size);
+                                                                   return true;
+                                                               });
+
+                              if (status != FileReader::Status::Ok)
+                              {
+                                  // Siblings stopped by the abort report Cancelled; keep the status that caused it.
+                                  auto expected = FileReader::Status::Ok;
+                                  failure.compare_exchange_strong(expected, status);
+                                  aborted.store(true, std::memory_order_relaxed);
+                                  return;
+                              }
+
+                              sha256_finalize(&sha_buff);
+                              sha256_read(&sha_buff, chunks[index].data());
+                          });
+
+    return failure.load();
+}
+
+bool CyberlibsCore::ChunkedHash::fromHex(std::string_view hex, Digest& digest)
+{
+    if (hex.size() != digest.size() * 2)
+    {
+        return false;
+    }
+
+    auto nibble = [](char c) -> int
+    {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F')
+            return c - 'A' + 10;
+        return -1;
+    };
+
+    for (size_t i = 0; i < digest.size(); ++i)
+    {
+        int high = nibble(hex[i * 2]);
+        int low = nibble(hex[i * 2 + 1]);
+        if (high < 0 || low < 0)
+        {
+            return false;
+        }
+
+        digest[i] = static_cast<uint8_t>(high << 4 | low);
+    }
+
+    return true;
+}
+
+std::string_view CyberlibsCore::ChunkedHash::trim(std::string_view text)
+{
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string_view::npos)
+    {
+        return std::string_view();
+    }
+
+    size_t end = text.find_last_not_of(" \t\r");
+
+    return text.substr(start, end - start + 1);
+}
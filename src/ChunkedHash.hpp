@@ -0,0 +1,66 @@
+#pragma once
+
+#include <sha256.h>
+#include "FileReader.hpp"
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Per-chunk SHA-256 digests of a file plus a Merkle root over them. Leaves are SHA-256(0x00 || chunk) and inner
+// nodes SHA-256(0x01 || left || right); an odd node is carried up unchanged.
+class ChunkedHash
+{
+public:
+    using Digest = std::array<uint8_t, 32>;
+
+    struct ByteRange
+    {
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    struct Manifest
+    {
+        uint64_t fileSize = 0;
+        uint64_t chunkSize = 0;
+        std::vector<Digest> chunks;
+        Digest root = {};
+    };
+
+    struct VerifyResult
+    {
+        Digest root = {};
+        std::vector<ByteRange> mismatches;
+    };
+
+    static constexpr uint64_t DEFAULT_CHUNK_SIZE = 4 * 1024 * 1024;
+
+    static FileReader::Status Build(const std::filesystem::path& path, uint64_t chunkSize, uint32_t maxThreads,
+                                    const FileReader::Options& readOptions, Manifest& manifest);
+
+    // Re-hashes the chunks overlapping changedRanges (every chunk when empty) and reports the byte ranges whose
+    // digests no longer match the manifest. Chunks outside changedRanges are trusted to be unchanged.
+    static FileReader::Status Verify(const std::filesystem::path& path, const Manifest& manifest,
+                                     const std::vector<ByteRange>& changedRanges, uint32_t maxThreads,
+                                     const FileReader::Options& readOptions, VerifyResult& result);
+
+    static Digest ComputeRoot(const std::vector<Digest>& chunks);
+    static std::string ToHex(const Digest& digest);
+    static std::string Serialize(const Manifest& manifest);
+    static bool Parse(std::string_view text, Manifest& manifest);
+
+private:
+    static uint64_t chunkCount(uint64_t fileSize, uint64_t chunkSize);
+    static FileReader::Status hashChunks(const std::filesystem::path& path, uint64_t chunkSize,
+                                         const std::vector<uint64_t>& indices, uint32_t maxThreads,
+                                         const FileReader::Options& readOptions, std::vector<Digest>& chunks);
+    static bool fromHex(std::string_view hex, Digest& digest);
+    static std::string_view trim(std::string_view text);
+};
+} // namespace CyberlibsCore
@@ -2,6 +2,7 @@
 
 #include <RED4ext/RED4ext.hpp>
 #include <RedLib.hpp>
+#include "GameDiagnostics.hpp"
 
 namespace CyberlibsCore
 {
@@ -11,6 +12,8 @@ public:
     Red::CString hash;
     Red::CString filePath;
     bool isCalculating;
+    uint64_t handle;
+    float progress;
 };
 
 struct CyberlibsAsyncHelperVerifyPathsQuery
@@ -19,6 +22,17 @@ public:
     bool isValid;
     Red::CString filePath;
     bool isCalculating;
+    uint64_t handle;
+    float progress;
+};
+
+struct CyberlibsAsyncHelperArchiveIndexesQuery
+{
+public:
+    Red::DynArray<GameDiagnosticsArchiveInfo> archives;
+    bool isCalculating;
+    uint64_t handle;
+    float progress;
 };
 
 class CyberlibsAsyncHelper : public Red::IGameSystem
@@ -30,6 +44,8 @@ public:
         Red::CString hash;
         Red::CString filePath;
         bool isCalculating;
+        uint64_t handle;
+        float progress;
     };
 
     struct VerifyPathsQuery
@@ -38,6 +54,8 @@ public:
         bool isValid;
         Red::CString filePath;
         bool isCalculating;
+        uint64_t handle;
+        float progress;
     };
 
     bool IsAttached() const
@@ -69,6 +87,8 @@ RTTI_DEFINE_CLASS(CyberlibsCore::CyberlibsAsyncHelperHashQuery, {
     RTTI_PROPERTY(hash);
     RTTI_PROPERTY(filePath);
     RTTI_PROPERTY(isCalculating);
+    RTTI_PROPERTY(handle);
+    RTTI_PROPERTY(progress);
 });
 
 RTTI_DEFINE_CLASS(CyberlibsCore::CyberlibsAsyncHelperVerifyPathsQuery, {
@@ -77,6 +97,17 @@ RTTI_DEFINE_CLASS(CyberlibsCore::CyberlibsAsyncHelperVerifyPathsQuery, {
     RTTI_PROPERTY(isValid);
     RTTI_PROPERTY(filePath);
     RTTI_PROPERTY(isCalculating);
+    RTTI_PROPERTY(handle);
+    RTTI_PROPERTY(progress);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::CyberlibsAsyncHelperArchiveIndexesQuery, {
+    RTTI_ALIAS("CyberlibsCore.CyberlibsAsyncHelperArchiveIndexesQuery");
+
+    RTTI_PROPERTY(archives);
+    RTTI_PROPERTY(isCalculating);
+    RTTI_PROPERTY(handle);
+    RTTI_PROPERTY(progress);
 });
 
 RTTI_DEFINE_CLASS(CyberlibsCore::CyberlibsAsyncHelper, {
@@ -0,0 +1,159 @@
+#include "DiagnosticsJobs.hpp"
+
+#include <algorithm>
+
+void CyberlibsCore::DiagnosticsJob::SetTotals(uint64_t bytesTotal, uint32_t filesTotal)
+{
+    bytesTotal_.store(bytesTotal, std::memory_order_relaxed);
+    filesTotal_.store(filesTotal, std::memory_order_relaxed);
+}
+
+void CyberlibsCore::DiagnosticsJob::AddBytes(uint64_t bytes)
+{
+    bytesDone_.fetch_add(bytes, std::memory_order_relaxed);
+    reportIfDue();
+}
+
+void CyberlibsCore::DiagnosticsJob::AddFiles(uint32_t files)
+{
+    filesDone_.fetch_add(files, std::memory_order_relaxed);
+    reportIfDue();
+}
+
+void CyberlibsCore::DiagnosticsJob::Complete()
+{
+    if (completed_.exchange(true, std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    uint64_t bytesTotal = bytesTotal_.load(std::memory_order_relaxed);
+    uint32_t filesTotal = filesTotal_.load(std::memory_order_relaxed);
+    bytesDone_.store((std::max)(bytesDone_.load(std::memory_order_relaxed), bytesTotal), std::memory_order_relaxed);
+    filesDone_.store((std::max)(filesDone_.load(std::memory_order_relaxed), filesTotal), std::memory_order_relaxed);
+
+    if (reporter_ && !IsCancelled())
+    {
+        reporter_(GetProgress());
+    }
+}
+
+CyberlibsCore::DiagnosticsJob::Progress CyberlibsCore::DiagnosticsJob::GetProgress() const
+{
+    Progress progress;
+    progress.handle = handle_;
+    progress.bytesDone = bytesDone_.load(std::memory_order_relaxed);
+    progress.bytesTotal = bytesTotal_.load(std::memory_order_relaxed);
+    progress.filesDone = filesDone_.load(std::memory_order_relaxed);
+    progress.filesTotal = filesTotal_.load(std::memory_order_relaxed);
+
+    return progress;
+}
+
+// Private Helpers
+
+void CyberlibsCore::DiagnosticsJob::reportIfDue()
+{
+    if (!reporter_ || IsCancelled() || completed_.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    int64_t now = std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now().time_since_epoch())
+                      .count();
+    int64_t last = lastReport_.load(std::memory_order_relaxed);
+    if (now - last < REPORT_INTERVAL.count())
+    {
+        return;
+    }
+
+    // Only the worker that wins the exchange reports, so parallel hashing cannot flood the script side.
+    if (lastReport_.compare_exchange_strong(last, now, std::memory_order_relaxed))
+    {
+        reporter_(GetProgress());
+    }
+}
+
+std::shared_ptr<CyberlibsCore::DiagnosticsJob> CyberlibsCore::DiagnosticsJobs::Create()
+{
+    auto job = std::make_shared<DiagnosticsJob>(nextHandle_.fetch_add(1));
+
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    jobs_[job->GetHandle()] = job;
+    job->subscribers_ = 1;
+    if (shuttingDown_)
+    {
+        job->Cancel();
+    }
+
+    return job;
+}
+
+uint64_t CyberlibsCore::DiagnosticsJobs::Subscribe(const std::shared_ptr<DiagnosticsJob>& job)
+{
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    if (job->IsCancelled())
+    {
+        return 0;
+    }
+
+    uint64_t handle = nextHandle_.fetch_add(1);
+    jobs_[handle] = job;
+    job->subscribers_++;
+
+    return handle;
+}
+
+std::shared_ptr<CyberlibsCore::DiagnosticsJob> CyberlibsCore::DiagnosticsJobs::Find(uint64_t handle)
+{
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    auto it = jobs_.find(handle);
+
+    return it != jobs_.end() ? it->second : nullptr;
+}
+
+bool CyberlibsCore::DiagnosticsJobs::IsSubscribed(uint64_t handle)
+{
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+
+    return jobs_.find(handle) != jobs_.end();
+}
+
+void CyberlibsCore::DiagnosticsJobs::Release(const DiagnosticsJob& job)
+{
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    for (auto it = jobs_.begin(); it != jobs_.end();)
+    {
+        it = it->second.get() == &job ? jobs_.erase(it) : std::next(it);
+    }
+}
+
+bool CyberlibsCore::DiagnosticsJobs::Cancel(uint64_t handle)
+{
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    auto it = jobs_.find(handle);
+    if (it == jobs_.end())
+    {
+        return false;
+    }
+
+    auto job = it->second;
+    jobs_.erase(it);
+    if (--job->subscribers_ == 0)
+    {
+        job->Cancel();
+    }
+
+    return true;
+}
+
+void CyberlibsCore::DiagnosticsJobs::CancelAll()
+{
+    std::lock_guard<std::mutex> lock(jobsMutex_);
+    shuttingDown_ = true;
+    for (const auto& [handle, job] : jobs_)
+    {
+        job->Cancel();
+    }
+}
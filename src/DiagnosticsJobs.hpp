@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace CyberlibsCore
+{
+class DiagnosticsJob
+{
+public:
+    struct Progress
+    {
+        uint64_t handle;
+        uint64_t bytesDone;
+        uint64_t bytesTotal;
+        uint32_t filesDone;
+        uint32_t filesTotal;
+    };
+
+    using Reporter = std::function<void(const Progress& progress)>;
+
+    static constexpr auto REPORT_INTERVAL = std::chrono::milliseconds(100);
+
+    explicit DiagnosticsJob(uint64_t handle)
+        : handle_(handle)
+    {
+    }
+
+    uint64_t GetHandle() const
+    {
+        return handle_;
+    }
+
+    bool IsCancelled() const
+    {
+        return cancelled_.load(std::memory_order_relaxed);
+    }
+
+    void Cancel()
+    {
+        cancelled_.store(true, std::memory_order_relaxed);
+    }
+
+    // Must be called before the job is dispatched; reporters are invoked from worker threads.
+    void SetReporter(Reporter reporter)
+    {
+        reporter_ = std::move(reporter);
+    }
+
+    void SetTotals(uint64_t bytesTotal, uint32_t filesTotal);
+    void AddBytes(uint64_t bytes);
+    void AddFiles(uint32_t files);
+    // Brings the counters up to their totals and reports once more, whatever the interval, so the last report a
+    // script sees is the finished one. Files served from a cache never add their bytes, and the throttle can swallow
+    // the final chunk. Later updates are not reported.
+    void Complete();
+    Progress GetProgress() const;
+
+private:
+    void reportIfDue();
+
+    const uint64_t handle_;
+    std::atomic<bool> cancelled_{false};
+    std::atomic<uint64_t> bytesDone_{0};
+    std::atomic<uint64_t> bytesTotal_{0};
+    std::atomic<uint32_t> filesDone_{0};
+    std::atomic<uint32_t> filesTotal_{0};
+    std::atomic<int64_t> lastReport_{0};
+    std::atomic<bool> completed_{false};
+    Reporter reporter_;
+    // Live subscriber handles, guarded by DiagnosticsJobs::jobsMutex_.
+    uint32_t subscribers_ = 0;
+
+    friend class DiagnosticsJobs;
+};
+
+class DiagnosticsJobs
+{
+public:
+    // Unregisters the job and all of its subscriber handles once the worker finishes, whichever way it exits.
+    class Scope
+    {
+        std::shared_ptr<DiagnosticsJob> job_;
+
+    public:
+        explicit Scope(const std::shared_ptr<DiagnosticsJob>& job)
+            : job_(job)
+        {
+        }
+
+        ~Scope()
+        {
+            Release(*job_);
+        }
+    };
+
+    // Registers a new job; its own handle is the first subscriber.
+    static std::shared_ptr<DiagnosticsJob> Create();
+    // Adds another handle for a running job. Returns 0 once the job has been cancelled.
+    static uint64_t Subscribe(const std::shared_ptr<DiagnosticsJob>& job);
+    static std::shared_ptr<DiagnosticsJob> Find(uint64_t handle);
+    static bool IsSubscribed(uint64_t handle);
+    static void Release(const DiagnosticsJob& job);
+    // Detaches the handle; the job itself stops only when no subscribers are left.
+    static bool Cancel(uint64_t handle);
+    // Cancels every registered job and every job created from now on. Called on shutdown.
+    static void CancelAll();
+
+private:
+    static inline std::mutex jobsMutex_;
+    static inline std::unordered_map<uint64_t, std::shared_ptr<DiagnosticsJob>> jobs_;
+    static inline std::atomic<uint64_t> nextHandle_{1};
+    static inline bool shuttingDown_ = false;
+};
+} // namespace CyberlibsCore
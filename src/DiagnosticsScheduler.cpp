@@ -0,0 +1,323 @@
+#include "DiagnosticsScheduler.hpp"
+#include "DiagnosticsJobs.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <iterator>
+
+CyberlibsCore::DiagnosticsScheduler::PriorityScope::PriorityScope(Priority priority)
+    : previous_(currentPriority_)
+{
+    applyThreadPriority(priority, previous_);
+    currentPriority_ = priority;
+}
+
+CyberlibsCore::DiagnosticsScheduler::PriorityScope::~PriorityScope()
+{
+    applyThreadPriority(previous_, currentPriority_);
+    currentPriority_ = previous_;
+}
+
+void CyberlibsCore::DiagnosticsScheduler::Submit(Priority priority, Work work, Work drop)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_)
+        {
+            startWorkers();
+
+            auto& queue = queues_[static_cast<size_t>(priority)];
+            queue.work.push_back({std::move(work), std::move(drop)});
+            queue.stats.queued++;
+            drop = nullptr;
+        }
+    }
+
+    if (drop)
+    {
+        drop();
+
+        return;
+    }
+
+    wake_.notify_all();
+}
+
+CyberlibsCore::DiagnosticsScheduler::Stats CyberlibsCore::DiagnosticsScheduler::GetStats()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Stats stats;
+    for (size_t i = 0; i < PRIORITY_COUNT; ++i)
+    {
+        stats.classes[i] = queues_[i].stats;
+    }
+
+    stats.concurrency = concurrency();
+
+    return stats;
+}
+
+CyberlibsCore::DiagnosticsScheduler::Priority CyberlibsCore::DiagnosticsScheduler::GetCurrentPriority()
+{
+    return currentPriority_;
+}
+
+uint32_t CyberlibsCore::DiagnosticsScheduler::ThreadBudget(int32_t requested)
+{
+    uint32_t budget = helperCount() + 1;
+    if (requested <= 0)
+    {
+        return budget;
+    }
+
+    return (std::min)(static_cast<uint32_t>(requested), budget);
+}
+
+bool CyberlibsCore::DiagnosticsScheduler::Help(Work work)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_)
+        {
+            return false;
+        }
+
+        if (helpers_.empty())
+        {
+            for (uint32_t i = 0; i < helperCount(); ++i)
+            {
+                helpers_.emplace_back(helperLoop);
+            }
+        }
+
+        helperWork_.push_back(std::move(work));
+    }
+
+    helperWake_.notify_one();
+
+    return true;
+}
+
+void CyberlibsCore::DiagnosticsScheduler::Shutdown()
+{
+    // Running jobs see the cancellation at their next read, so joining below does not wait out a long hash.
+    DiagnosticsJobs::CancelAll();
+
+    std::vector<std::thread> threads;
+    std::vector<Work> drops;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (auto& queue : queues_)
+        {
+            for (auto& entry : queue.work)
+            {
+                if (entry.drop)
+                {
+                    drops.push_back(std::move(entry.drop));
+                }
+            }
+
+            queue.work.clear();
+            queue.stats.queued = 0;
+        }
+
+        helperWork_.clear();
+        threads.swap(workers_);
+        threads.insert(threads.end(), std::make_move_iterator(helpers_.begin()),
+                       std::make_move_iterator(helpers_.end()));
+        helpers_.clear();
+    }
+
+    wake_.notify_all();
+    helperWake_.notify_all();
+
+    for (auto& drop : drops)
+    {
+        try
+        {
+            drop();
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+// Private Helpers
+
+uint32_t CyberlibsCore::DiagnosticsScheduler::concurrency()
+{
+    // Leaves most of the machine to the game; hashing is I/O bound long before it is CPU bound anyway.
+    uint32_t hardwareThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+    return std::clamp(hardwareThreads / 4, 1u, MAX_CONCURRENCY);
+}
+
+uint32_t CyberlibsCore::DiagnosticsScheduler::helperCount()
+{
+    // Together with the job threads this stays around half the machine, however many jobs run at once.
+    uint32_t hardwareThreads = (std::max)(std::thread::hardware_concurrency(), 1u);
+
+    return (std::max)(hardwareThreads / 2, 2u) - 1;
+}
+
+void CyberlibsCore::DiagnosticsScheduler::startWorkers()
+{
+    if (!workers_.empty())
+    {
+        return;
+    }
+
+    for (uint32_t i = 0; i < concurrency(); ++i)
+    {
+        workers_.emplace_back(workerLoop);
+    }
+}
+
+bool CyberlibsCore::DiagnosticsScheduler::canRun(Priority priority)
+{
+    const auto& interactive = queues_[static_cast<size_t>(Priority::Interactive)];
+    const auto& background = queues_[static_cast<size_t>(Priority::Background)];
+    const auto& idle = queues_[static_cast<size_t>(Priority::Idle)];
+
+    switch (priority)
+    {
+    case Priority::Interactive:
+        return !interactive.work.empty();
+    case Priority::Background:
+    {
+        // Low-priority work never takes the last worker, so an interactive request is picked up right away.
+        uint32_t lowPriorityRunning = background.stats.running + idle.stats.running;
+        return !background.work.empty() && (concurrency() == 1 || lowPriorityRunning + 1 < concurrency());
+    }
+    case Priority::Idle:
+    {
+        uint32_t lowPriorityRunning = background.stats.running + idle.stats.running;
+        return !idle.work.empty() && interactive.work.empty() && background.work.empty() &&
+               (concurrency() == 1 || lowPriorityRunning + 1 < concurrency());
+    }
+    }
+
+    return false;
+}
+
+void CyberlibsCore::DiagnosticsScheduler::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true)
+    {
+        Priority priority = Priority::Interactive;
+        wake_.wait(lock,
+                   [&priority]()
+                   {
+                       if (stopping_)
+                       {
+                           return true;
+                       }
+
+                       for (auto candidate : {Priority::Interactive, Priority::Background, Priority::Idle})
+                       {
+                           if (canRun(candidate))
+                           {
+                               priority = candidate;
+                               return true;
+                           }
+                       }
+
+                       return false;
+                   });
+
+        if (stopping_)
+        {
+            return;
+        }
+
+        auto& queue = queues_[static_cast<size_t>(priority)];
+        Work work = std::move(queue.work.front().work);
+        queue.work.pop_front();
+        queue.stats.queued--;
+        queue.stats.running++;
+
+        lock.unlock();
+
+        {
+            PriorityScope priorityScope(priority);
+            try
+            {
+                work();
+            }
+            catch (const std::exception&)
+            {
+            }
+        }
+
+        lock.lock();
+        queue.stats.running--;
+        queue.stats.completed++;
+
+        // A finished low-priority job may unblock work that was held back for the reserved worker.
+        wake_.notify_all();
+    }
+}
+
+void CyberlibsCore::DiagnosticsScheduler::helperLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true)
+    {
+        helperWake_.wait(lock, []() { return stopping_ || !helperWork_.empty(); });
+        if (stopping_)
+        {
+            return;
+        }
+
+        Work work = std::move(helperWork_.front());
+        helperWork_.pop_front();
+
+        lock.unlock();
+
+        try
+        {
+            work();
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        lock.lock();
+    }
+}
+
+void CyberlibsCore::DiagnosticsScheduler::applyThreadPriority(Priority priority, Priority previous)
+{
+    HANDLE thread = GetCurrentThread();
+    bool wasBackground = previous != Priority::Interactive;
+    bool isBackground = priority != Priority::Interactive;
+
+    if (wasBackground && !isBackground)
+    {
+        SetThreadPriority(thread, THREAD_MODE_BACKGROUND_END);
+    }
+    else if (!wasBackground && isBackground)
+    {
+        SetThreadPriority(thread, THREAD_MODE_BACKGROUND_BEGIN);
+    }
+
+    if (isBackground)
+    {
+        SetThreadPriority(thread, priority == Priority::Idle ? THREAD_PRIORITY_IDLE : THREAD_PRIORITY_LOWEST);
+    }
+    else
+    {
+        SetThreadPriority(thread, THREAD_PRIORITY_NORMAL);
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <windows.h>
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Runs diagnostics work on a few dedicated threads instead of the engine's shared job workers, so bursts of
+// hashing cannot starve streaming or other frame-critical jobs. Parallel steps inside a job borrow from one shared
+// set of helper threads, so all diagnostics work together stays within a fixed number of threads.
+class DiagnosticsScheduler
+{
+public:
+    enum class Priority : uint32_t
+    {
+        Interactive,
+        Background,
+        Idle
+    };
+
+    static constexpr size_t PRIORITY_COUNT = 3;
+    static constexpr uint32_t MAX_CONCURRENCY = 2;
+
+    struct ClassStats
+    {
+        uint32_t queued;
+        uint32_t running;
+        uint64_t completed;
+    };
+
+    struct Stats
+    {
+        std::array<ClassStats, PRIORITY_COUNT> classes;
+        uint32_t concurrency;
+    };
+
+    // Applies a priority class to the current thread and restores normal priority on exit. Background and idle work
+    // runs in background processing mode, which also lowers its disk I/O and memory priority.
+    class PriorityScope
+    {
+        Priority previous_;
+
+    public:
+        explicit PriorityScope(Priority priority);
+        ~PriorityScope();
+    };
+
+    using Work = std::function<void()>;
+
+    // drop runs instead of work if the scheduler shuts down first, so the caller can reject whoever is waiting.
+    static void Submit(Priority priority, Work work, Work drop = nullptr);
+    static Stats GetStats();
+    // Priority of the work running on the calling thread; helper work started by it should adopt it.
+    static Priority GetCurrentPriority();
+    // Threads a parallel step may use, the calling thread included. The request is capped by the helper threads;
+    // zero or less asks for all of them.
+    static uint32_t ThreadBudget(int32_t requested);
+    // Hands work to a shared helper thread. Returns false once shutdown has begun. Helper work that has not started
+    // by then is dropped without running, so callers must never wait for it to start.
+    static bool Help(Work work);
+    // Cancels every job, rejects queued work through its drop callback and joins all threads. Called when the
+    // plugin unloads.
+    static void Shutdown();
+
+private:
+    struct Entry
+    {
+        Work work;
+        Work drop;
+    };
+
+    struct Queue
+    {
+        std::deque<Entry> work;
+        ClassStats stats;
+    };
+
+    static uint32_t concurrency();
+    static uint32_t helperCount();
+    static void startWorkers();
+    static bool canRun(Priority priority);
+    static void workerLoop();
+    static void helperLoop();
+    static void applyThreadPriority(Priority priority, Priority previous);
+
+    static inline std::mutex mutex_;
+    static inline std::condition_variable wake_;
+    static inline std::array<Queue, PRIORITY_COUNT> queues_;
+    static inline std::vector<std::thread> workers_;
+    static inline std::condition_variable helperWake_;
+    static inline std::deque<Work> helperWork_;
+    static inline std::vector<std::thread> helpers_;
+    static inline bool stopping_ = false;
+    static inline thread_local Priority currentPriority_ = Priority::Interactive;
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,99 @@
+#include "DirectoryScanner.hpp"
+
+#include <algorithm>
+
+bool CyberlibsCore::DirectoryScanner::List(const std::filesystem::path& directory, Listing& listing)
+{
+    listing.clear();
+
+    return Enumerate(directory, [&listing](std::wstring&& name, const Entry& entry)
+                     { listing.emplace(FoldCase(std::move(name)), entry); });
+}
+
+bool CyberlibsCore::DirectoryScanner::Enumerate(const std::filesystem::path& directory, const Visitor& visitor)
+{
+    // FindExInfoBasic skips the short 8.3 names and LARGE_FETCH pulls bigger batches per kernel call.
+    WIN32_FIND_DATAW findData;
+    HANDLE hFind = FindFirstFileExW((directory / L"*").c_str(), FindExInfoBasic, &findData, FindExSearchNameMatch,
+                                    NULL, FIND_FIRST_EX_LARGE_FETCH);
+    if (hFind == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    do
+    {
+        std::wstring name = findData.cFileName;
+        if (name == L"." || name == L"..")
+        {
+            continue;
+        }
+
+        Entry entry;
+        entry.size = (static_cast<uint64_t>(findData.nFileSizeHigh) << 32) | findData.nFileSizeLow;
+        entry.lastWriteTime = (static_cast<uint64_t>(findData.ftLastWriteTime.dwHighDateTime) << 32) |
+                              findData.ftLastWriteTime.dwLowDateTime;
+        entry.attributes = findData.dwFileAttributes;
+        visitor(std::move(name), entry);
+    } while (FindNextFileW(hFind, &findData));
+
+    FindClose(hFind);
+
+    return true;
+}
+
+bool CyberlibsCore::DirectoryScanner::Resolve(const std::filesystem::path& root, std::string_view relativePath,
+                                              std::filesystem::path& fullPath, std::wstring& name)
+{
+    std::string cleanPath(relativePath);
+    std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
+
+    size_t start = cleanPath.find_first_not_of('/');
+    size_t end = cleanPath.find_last_not_of('/');
+    cleanPath = start == std::string::npos ? std::string() : cleanPath.substr(start, end - start + 1);
+
+    // Manifest and script paths are UTF-8; a plain std::string would be read in the ANSI code page on Windows.
+    std::filesystem::path relative =
+        std::filesystem::path(std::u8string(cleanPath.begin(), cleanPath.end())).lexically_normal();
+    if (relative.has_root_name() || relative.has_root_directory() ||
+        (!relative.empty() && *relative.begin() == ".."))
+    {
+        return false;
+    }
+
+    // "missing/." normalises to "missing/", whose empty file name would mark it as the root.
+    if (!relative.empty() && !relative.has_filename())
+    {
+        relative = relative.parent_path();
+    }
+
+    if (relative.empty() || relative == ".")
+    {
+        // Only a path that was empty to begin with names the root. "mod/.." would otherwise turn a record about
+        // some entry into one about the root, which always exists.
+        if (!cleanPath.empty())
+        {
+            return false;
+        }
+
+        // The root itself always exists; an empty name marks it as such.
+        fullPath = root;
+        name.clear();
+        return true;
+    }
+
+    fullPath = root / relative;
+    name = FoldCase(fullPath.filename().wstring());
+
+    return true;
+}
+
+std::wstring CyberlibsCore::DirectoryScanner::FoldCase(std::wstring name)
+{
+    if (!name.empty())
+    {
+        CharUpperBuffW(name.data(), static_cast<DWORD>(name.size()));
+    }
+
+    return name;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <windows.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace CyberlibsCore
+{
+// Lists a directory with one FindFirstFileExW enumeration, so callers can answer many "does X exist" questions
+// about the same directory from memory instead of issuing a metadata query per file.
+class DirectoryScanner
+{
+public:
+    struct Entry
+    {
+        uint64_t size;
+        uint64_t lastWriteTime;
+        DWORD attributes;
+
+        bool IsDirectory() const
+        {
+            return (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+        }
+    };
+
+    // Keys are case-folded with FoldCase, matching how NTFS compares names.
+    using Listing = std::unordered_map<std::wstring, Entry>;
+
+    using Visitor = std::function<void(std::wstring&& name, const Entry& entry)>;
+
+    // Returns false if the directory cannot be enumerated (usually because it does not exist).
+    static bool List(const std::filesystem::path& directory, Listing& listing);
+    // Same enumeration, handing each entry to visitor with its name as stored on disk. "." and ".." are skipped.
+    static bool Enumerate(const std::filesystem::path& directory, const Visitor& visitor);
+    // Resolves a UTF-8 path relative to root and returns the case-folded name to look up in the listing of
+    // fullPath's parent. Returns false for paths that would leave root.
+    static bool Resolve(const std::filesystem::path& root, std::string_view relativePath,
+                        std::filesystem::path& fullPath, std::wstring& name);
+    static std::wstring FoldCase(std::wstring name);
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,312 @@
+#include "DirectoryTreeCache.hpp"
+#include "NotificationDirectoryWatcher.hpp"
+#include "PollingDirectoryWatcher.hpp"
+
+#include <algorithm>
+
+void CyberlibsCore::DirectoryTreeCache::Start(const std::filesystem::path& root, const WatcherFactory& makeWatcher)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (started_ && root_ == root && !makeWatcher)
+    {
+        return;
+    }
+
+    for (auto& subtree : subtrees_)
+    {
+        subtree.watcher->Stop();
+    }
+
+    subtrees_.clear();
+    root_ = root;
+    listings_.clear();
+    changes_.clear();
+    ++generation_;
+    started_ = true;
+
+    for (const wchar_t* key : WATCHED_SUBTREES)
+    {
+        // Folders that do not exist yet are not watched; lookups below them go to the disk.
+        auto directory = (root / key).lexically_normal();
+
+        std::unique_ptr<DirectoryWatcher> watcher;
+        bool isStarted = false;
+        if (makeWatcher)
+        {
+            watcher = makeWatcher();
+            isStarted = watcher && watcher->Start(directory);
+        }
+        else
+        {
+            watcher = std::make_unique<NotificationDirectoryWatcher>();
+            isStarted = watcher->Start(directory);
+            if (!isStarted)
+            {
+                watcher = std::make_unique<PollingDirectoryWatcher>();
+                isStarted = watcher->Start(directory);
+            }
+        }
+
+        if (isStarted)
+        {
+            subtrees_.push_back({key, std::move(watcher), generation_});
+        }
+    }
+}
+
+void CyberlibsCore::DirectoryTreeCache::Shutdown()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (auto& subtree : subtrees_)
+    {
+        subtree.watcher->Stop();
+    }
+
+    subtrees_.clear();
+    listings_.clear();
+    changes_.clear();
+    started_ = false;
+}
+
+bool CyberlibsCore::DirectoryTreeCache::Enumerate(const std::filesystem::path& directory,
+                                                  const DirectoryScanner::Visitor& visitor)
+{
+    std::wstring key;
+    Listing listing;
+    bool isCached = false;
+    bool isCurrent = false;
+    uint64_t listedGeneration = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        Subtree* subtree = nullptr;
+        if (started_ && toKey(directory, key))
+        {
+            refresh();
+            subtree = findSubtree(key);
+        }
+
+        if (!subtree)
+        {
+            return DirectoryScanner::Enumerate(directory, visitor);
+        }
+
+        auto it = listings_.find(key);
+        isCached = it != listings_.end();
+        if (isCached)
+        {
+            listing = it->second;
+        }
+
+        // A polling watcher only sees entries come and go, so a cached listing from it may hold old sizes and
+        // write times; it is read again and only serves to tell whether anything changed.
+        isCurrent = isCached && subtree->watcher->ReportsFileEdits();
+        if (!isCurrent)
+        {
+            // Track first, so a change landing while the directory is being listed still shows up on the next poll.
+            subtree->watcher->Track(directory, PollingDirectoryWatcher::QueryLastWriteTime(directory));
+            listedGeneration = generation_;
+        }
+    }
+
+    if (isCurrent)
+    {
+        refreshVolatile(directory, listing);
+    }
+    else
+    {
+        Listing fresh;
+        fresh.exists = DirectoryScanner::Enumerate(
+            directory, [&fresh](std::wstring&& name, const DirectoryScanner::Entry& info)
+            { fresh.entries.push_back({std::move(name), info}); });
+
+        // A change applied by another thread meanwhile may already have invalidated this directory; caching the
+        // listing then could keep it stale forever.
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (started_ && generation_ == listedGeneration)
+        {
+            if (isCached && !(fresh == listing))
+            {
+                ++generation_;
+                invalidate(key);
+                recordChange(key);
+            }
+
+            listings_.insert_or_assign(key, fresh);
+        }
+
+        listing = std::move(fresh);
+    }
+
+    for (auto& entry : listing.entries)
+    {
+        visitor(std::move(entry.name), entry.info);
+    }
+
+    return listing.exists;
+}
+
+uint64_t CyberlibsCore::DirectoryTreeCache::GetGeneration()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (started_)
+    {
+        refresh();
+    }
+
+    return generation_;
+}
+
+bool CyberlibsCore::DirectoryTreeCache::HasChangedSince(const std::filesystem::path& directory, uint64_t generation)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    std::wstring key;
+    if (!started_ || !toKey(directory, key))
+    {
+        return true;
+    }
+
+    refresh();
+
+    const Subtree* subtree = findSubtree(key);
+    if (!subtree || !subtree->watcher->ReportsFileEdits() || generation < subtree->resetGeneration)
+    {
+        return true;
+    }
+
+    auto it = changes_.find(key);
+
+    return it != changes_.end() && it->second > generation;
+}
+
+// Private Helpers
+
+bool CyberlibsCore::DirectoryTreeCache::toKey(const std::filesystem::path& directory, std::wstring& key)
+{
+    auto relative = directory.lexically_normal().lexically_relative(root_);
+    if (relative.empty() || *relative.begin() == "..")
+    {
+        return false;
+    }
+
+    key = relative == "." ? std::wstring() : DirectoryScanner::FoldCase(relative.generic_wstring());
+    while (!key.empty() && key.back() == L'/')
+    {
+        key.pop_back();
+    }
+
+    return true;
+}
+
+CyberlibsCore::DirectoryTreeCache::Subtree* CyberlibsCore::DirectoryTreeCache::findSubtree(const std::wstring& key)
+{
+    for (auto& subtree : subtrees_)
+    {
+        if (key.compare(0, subtree.key.size(), subtree.key) == 0 &&
+            (key.size() == subtree.key.size() || key[subtree.key.size()] == L'/'))
+        {
+            return &subtree;
+        }
+    }
+
+    return nullptr;
+}
+
+void CyberlibsCore::DirectoryTreeCache::refresh()
+{
+    std::vector<std::filesystem::path> changed;
+    for (auto& subtree : subtrees_)
+    {
+        changed.clear();
+        if (!subtree.watcher->Poll(changed))
+        {
+            ++generation_;
+            invalidate(subtree.key);
+            recordChange(subtree.key);
+            subtree.resetGeneration = generation_;
+            continue;
+        }
+
+        if (changed.empty())
+        {
+            continue;
+        }
+
+        ++generation_;
+        for (const auto& directory : changed)
+        {
+            std::wstring key;
+            if (toKey(directory, key))
+            {
+                invalidate(key);
+                recordChange(std::move(key));
+            }
+        }
+    }
+}
+
+void CyberlibsCore::DirectoryTreeCache::invalidate(const std::wstring& key)
+{
+    // The directory and everything cached below it: a renamed or removed folder takes its subtree along.
+    listings_.erase(key);
+
+    std::wstring prefix = key.empty() ? key : key + L'/';
+    auto it = listings_.lower_bound(prefix);
+    while (it != listings_.end() && it->first.compare(0, prefix.size(), prefix) == 0)
+    {
+        it = listings_.erase(it);
+    }
+}
+
+void CyberlibsCore::DirectoryTreeCache::recordChange(std::wstring key)
+{
+    // Ancestors are marked too, so asking about any folder above the change finds it with one lookup.
+    while (true)
+    {
+        changes_.insert_or_assign(key, generation_);
+        if (key.empty())
+        {
+            break;
+        }
+
+        size_t slashPos = key.rfind(L'/');
+        key.resize(slashPos == std::wstring::npos ? 0 : slashPos);
+    }
+}
+
+void CyberlibsCore::DirectoryTreeCache::refreshVolatile(const std::filesystem::path& directory, Listing& listing)
+{
+    // Watchers skip edits to logs and databases, so their cached size and write time are re-read on every lookup.
+    for (auto& entry : listing.entries)
+    {
+        if (entry.info.IsDirectory() || !DirectoryWatcher::IsVolatile(entry.name))
+        {
+            continue;
+        }
+
+        WIN32_FILE_ATTRIBUTE_DATA fileInfo;
+        if (GetFileAttributesExW((directory / entry.name).c_str(), GetFileExInfoStandard, &fileInfo))
+        {
+            entry.info.size = (static_cast<uint64_t>(fileInfo.nFileSizeHigh) << 32) | fileInfo.nFileSizeLow;
+            entry.info.lastWriteTime = (static_cast<uint64_t>(fileInfo.ftLastWriteTime.dwHighDateTime) << 32) |
+                                       fileInfo.ftLastWriteTime.dwLowDateTime;
+            entry.info.attributes = fileInfo.dwFileAttributes;
+        }
+    }
+}
+
+bool CyberlibsCore::DirectoryTreeCache::Listing::operator==(const Listing& other) const
+{
+    auto sameEntry = [](const NamedEntry& left, const NamedEntry& right)
+    {
+        return left.name == right.name && left.info.size == right.info.size &&
+               left.info.lastWriteTime == right.info.lastWriteTime && left.info.attributes == right.info.attributes;
+    };
+
+    return exists == other.exists &&
+           std::equal(entries.begin(), entries.end(), other.entries.begin(), other.entries.end(), sameEntry);
+}
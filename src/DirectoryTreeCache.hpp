@@ -0,0 +1,83 @@
+#pragma once
+
+#include "DirectoryScanner.hpp"
+#include "DirectoryWatcher.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Keeps the listings of mod directories between scans. Each folder mods are installed to gets its own
+// DirectoryWatcher, which reports the directories that changed; only those are listed again, and every batch of
+// changes advances a generation counter so scripts can ask whether anything under a path changed since they last
+// looked. The rest of the game directory (the executable, caches, saves) is never watched or cached.
+class DirectoryTreeCache
+{
+public:
+    using WatcherFactory = std::function<std::unique_ptr<DirectoryWatcher>()>;
+
+    // Starts caching under root. Without a factory, change notifications are tried first for each watched folder
+    // and polling is the fallback. Calling it again for the same root does nothing.
+    static void Start(const std::filesystem::path& root, const WatcherFactory& makeWatcher = nullptr);
+    static void Shutdown();
+
+    // Drop-in for DirectoryScanner::Enumerate. Directories outside the watched folders are listed directly.
+    static bool Enumerate(const std::filesystem::path& directory, const DirectoryScanner::Visitor& visitor);
+    static uint64_t GetGeneration();
+    // True if directory or anything below it changed after generation was current. Always true when that cannot be
+    // ruled out: outside the watched folders, or under one watched by polling, which misses in-place edits.
+    static bool HasChangedSince(const std::filesystem::path& directory, uint64_t generation);
+
+private:
+    struct NamedEntry
+    {
+        std::wstring name;
+        DirectoryScanner::Entry info;
+    };
+
+    struct Listing
+    {
+        std::vector<NamedEntry> entries;
+        bool exists;
+
+        bool operator==(const Listing& other) const;
+    };
+
+    struct Subtree
+    {
+        std::wstring key;
+        std::unique_ptr<DirectoryWatcher> watcher;
+        // Everything below counts as changed for generations before this one (lost notifications).
+        uint64_t resetGeneration;
+    };
+
+    // Case-folded roots of the watched folders, relative to the game root.
+    static constexpr const wchar_t* WATCHED_SUBTREES[] = {L"archive/pc/mod", L"bin/x64/plugins", L"mods",
+                                                          L"r6/scripts",     L"r6/tweaks",       L"red4ext"};
+
+    static bool toKey(const std::filesystem::path& directory, std::wstring& key);
+    static Subtree* findSubtree(const std::wstring& key);
+    static void refresh();
+    static void invalidate(const std::wstring& key);
+    static void recordChange(std::wstring key);
+    static void refreshVolatile(const std::filesystem::path& directory, Listing& listing);
+
+    static inline std::mutex mutex_;
+    static inline std::filesystem::path root_;
+    static inline std::vector<Subtree> subtrees_;
+    // Keys are case-folded, '/' separated paths relative to the root; ordered so a subtree is one contiguous range.
+    static inline std::map<std::wstring, Listing> listings_;
+    // Generation of the latest change at or below each directory.
+    static inline std::unordered_map<std::wstring, uint64_t> changes_;
+    static inline uint64_t generation_ = 1;
+    static inline bool started_ = false;
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,105 @@
+#include "DirectoryWalker.hpp"
+#include "DirectoryTreeCache.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+
+bool CyberlibsCore::DirectoryWalker::Walk(const std::filesystem::path& root, const Options& options,
+                                          std::vector<Entry>& entries)
+{
+    entries.clear();
+
+    std::vector<Frontier> level(1);
+    level[0].directory = root;
+    std::atomic<bool> rootListed{false};
+
+    for (uint32_t depth = 1; !level.empty() && !(options.job && options.job->IsCancelled()); ++depth)
+    {
+        std::vector<std::vector<Entry>> levelEntries(level.size());
+        std::vector<std::vector<Frontier>> nextLevels(level.size());
+        bool descend = options.maxDepth == 0 || depth < options.maxDepth;
+
+        WorkStealingPool::Run(
+            level.size(), options.maxThreads,
+            [&](size_t index)
+            {
+                if (options.job && options.job->IsCancelled())
+                {
+                    return;
+                }
+
+                const auto& frontier = level[index];
+                // Entries of one directory share its prefix; only the last component changes between them, and the
+                // vector is copied only for subdirectories that are walked next.
+                std::vector<std::wstring> components = frontier.components;
+                components.emplace_back();
+                bool listed = DirectoryTreeCache::Enumerate(
+                    frontier.directory,
+                    [&](std::wstring&& name, const DirectoryScanner::Entry& info)
+                    {
+                        components.back() = DirectoryScanner::FoldCase(name);
+                        if (matchesAny(options.exclude, components))
+                        {
+                            return;
+                        }
+
+                        std::string utf8Name = toUtf8(name);
+                        std::string relativePath =
+                            frontier.relativePath.empty() ? utf8Name : frontier.relativePath + "/" + utf8Name;
+                        bool isDirectory = info.IsDirectory();
+
+                        if ((isDirectory ? options.includeDirectories : options.includeFiles) &&
+                            (options.include.empty() || matchesAny(options.include, components)))
+                        {
+                            levelEntries[index].push_back({relativePath, utf8Name, info, depth});
+                        }
+
+                        if (isDirectory && descend && (info.attributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0)
+                        {
+                            nextLevels[index].push_back(
+                                {frontier.directory / name, std::move(relativePath), components});
+                        }
+                    });
+
+                if (listed && depth == 1)
+                {
+                    rootListed = true;
+                }
+            });
+
+        if (depth == 1 && !rootListed)
+        {
+            return false;
+        }
+
+        level.clear();
+        for (size_t i = 0; i < nextLevels.size(); ++i)
+        {
+            std::move(levelEntries[i].begin(), levelEntries[i].end(), std::back_inserter(entries));
+            std::move(nextLevels[i].begin(), nextLevels[i].end(), std::back_inserter(level));
+        }
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const Entry& a, const Entry& b) { return a.relativePath < b.relativePath; });
+
+    return true;
+}
+
+// Private Helpers
+
+bool CyberlibsCore::DirectoryWalker::matchesAny(const std::vector<GlobPattern>& patterns,
+                                                const std::vector<std::wstring>& components)
+{
+    return std::any_of(patterns.begin(), patterns.end(),
+                       [&components](const GlobPattern& pattern) { return pattern.Matches(components); });
+}
+
+std::string CyberlibsCore::DirectoryWalker::toUtf8(const std::wstring& text)
+{
+    auto utf8 = std::filesystem::path(text).u8string();
+
+    return std::string(utf8.begin(), utf8.end());
+}
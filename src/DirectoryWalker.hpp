@@ -0,0 +1,59 @@
+#pragma once
+
+#include "DiagnosticsJobs.hpp"
+#include "DirectoryScanner.hpp"
+#include "GlobPattern.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Recursive listing of a directory tree into one flat, sorted list. Each directory is enumerated with a single
+// DirectoryScanner pass, or served from DirectoryTreeCache when unchanged, and every level of the tree can be
+// spread over several threads.
+class DirectoryWalker
+{
+public:
+    struct Options
+    {
+        // Zero walks the whole tree, one lists only the direct children of the root.
+        uint32_t maxDepth = 0;
+        // Entries are reported only if they match one of these, or always when the list is empty.
+        std::vector<GlobPattern> include;
+        // Matching entries are never reported and matching directories are not descended into.
+        std::vector<GlobPattern> exclude;
+        bool includeFiles = true;
+        bool includeDirectories = true;
+        uint32_t maxThreads = 1;
+        // Stops the walk once cancelled; what was listed so far is still returned.
+        DiagnosticsJob* job = nullptr;
+    };
+
+    struct Entry
+    {
+        // UTF-8, relative to the walked root, '/' separated.
+        std::string relativePath;
+        std::string name;
+        DirectoryScanner::Entry info;
+        uint32_t depth;
+    };
+
+    // Returns false if the root cannot be enumerated. Entries come back sorted by relative path. Reparse points are
+    // reported but not followed.
+    static bool Walk(const std::filesystem::path& root, const Options& options, std::vector<Entry>& entries);
+
+private:
+    struct Frontier
+    {
+        std::filesystem::path directory;
+        std::string relativePath;
+        std::vector<std::wstring> components;
+    };
+
+    static bool matchesAny(const std::vector<GlobPattern>& patterns, const std::vector<std::wstring>& components);
+    static std::string toUtf8(const std::wstring& text);
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,21 @@
+#include "DirectoryWatcher.hpp"
+
+#include <algorithm>
+#include <cwctype>
+
+bool CyberlibsCore::DirectoryWatcher::IsVolatile(std::wstring_view name)
+{
+    auto equalsFolded = [](wchar_t c, wchar_t lower) { return static_cast<wchar_t>(std::towlower(c)) == lower; };
+
+    static constexpr std::wstring_view LOG_EXTENSION = L".log";
+    if (name.size() >= LOG_EXTENSION.size() &&
+        std::equal(name.end() - LOG_EXTENSION.size(), name.end(), LOG_EXTENSION.begin(), equalsFolded))
+    {
+        return true;
+    }
+
+    // db.sqlite3 and its -journal, -wal and -shm companions.
+    static constexpr std::wstring_view SQLITE_EXTENSION = L".sqlite3";
+    return std::search(name.begin(), name.end(), SQLITE_EXTENSION.begin(), SQLITE_EXTENSION.end(),
+                       equalsFolded) != name.end();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Source of "this directory changed" events for DirectoryTreeCache. Only the interface lives here, free of Windows
+// headers, so the cache can be driven by change notifications (NotificationDirectoryWatcher), by polling
+// (PollingDirectoryWatcher), or by a scripted implementation in tests.
+class DirectoryWatcher
+{
+public:
+    virtual ~DirectoryWatcher() = default;
+
+    // Returns false if this watcher cannot observe root; the cache then falls back to another implementation.
+    virtual bool Start(const std::filesystem::path& root) = 0;
+    virtual void Stop() = 0;
+    // False for watchers that only notice entries being added, removed or renamed. The cache then lists a directory
+    // again on every lookup instead of trusting the sizes and write times it holds.
+    virtual bool ReportsFileEdits() const = 0;
+    // Called with a directory's own last write time just before the cache lists it, for implementations that can
+    // only check what they were told about.
+    virtual void Track(const std::filesystem::path& directory, uint64_t lastWriteTime) = 0;
+    // Appends directories whose contents changed since the previous call. Returns false when changes were lost and
+    // every directory has to be treated as changed.
+    virtual bool Poll(std::vector<std::filesystem::path>& changedDirectories) = 0;
+
+    // Logs and SQLite databases (with their journals) are rewritten constantly while the game runs. Watchers do not
+    // report edits to them; the cache refreshes their entries whenever it serves a listing instead.
+    static bool IsVolatile(std::wstring_view name);
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,257 @@
+#include "FileReader.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace
+{
+struct ReadSlot
+{
+    OVERLAPPED overlapped;
+    uint8_t* data;
+    uint64_t position;
+    bool pending;
+};
+
+// Owns the in-flight reads; outstanding requests must be cancelled and drained before their buffers are released.
+struct ReadPipeline
+{
+    HANDLE file;
+    void* memory = nullptr;
+    ReadSlot slots[CyberlibsCore::FileReader::BLOCK_COUNT] = {};
+
+    explicit ReadPipeline(HANDLE file)
+        : file(file)
+    {
+    }
+
+    ~ReadPipeline()
+    {
+        for (auto& slot : slots)
+        {
+            if (slot.pending)
+            {
+                DWORD ignored = 0;
+                CancelIoEx(file, &slot.overlapped);
+                GetOverlappedResult(file, &slot.overlapped, &ignored, TRUE);
+            }
+
+            if (slot.overlapped.hEvent)
+            {
+                CloseHandle(slot.overlapped.hEvent);
+            }
+        }
+
+        if (memory)
+        {
+            VirtualFree(memory, 0, MEM_RELEASE);
+        }
+    }
+
+    bool Initialize()
+    {
+        constexpr size_t blockSize = CyberlibsCore::FileReader::BLOCK_SIZE;
+
+        // VirtualAlloc returns page-aligned memory, which satisfies the sector alignment unbuffered reads require.
+        memory = VirtualAlloc(NULL, blockSize * CyberlibsCore::FileReader::BLOCK_COUNT, MEM_COMMIT | MEM_RESERVE,
+                              PAGE_READWRITE);
+        if (!memory)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < CyberlibsCore::FileReader::BLOCK_COUNT; ++i)
+        {
+            slots[i].data = static_cast<uint8_t*>(memory) + i * blockSize;
+            slots[i].overlapped.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+            if (!slots[i].overlapped.hEvent)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+} // namespace
+
+CyberlibsCore::FileReader::Status CyberlibsCore::FileReader::Stream(const std::filesystem::path& path,
+                                                                    const Options& options, const Consumer& consumer)
+{
+    HANDLE hFile = Open(path, options);
+    if (hFile == INVALID_HANDLE_VALUE)
+    {
+        return Status::OpenFailed;
+    }
+
+    std::unique_ptr<void, decltype(&CloseHandle)> fileGuard(hFile, CloseHandle);
+
+    return Stream(hFile, options, consumer);
+}
+
+HANDLE CyberlibsCore::FileReader::Open(const std::filesystem::path& path, const Options& options)
+{
+    DWORD flags = FILE_ATTRIBUTE_NORMAL | FILE_FLAG_OVERLAPPED;
+    flags |= options.bypassCache ? FILE_FLAG_NO_BUFFERING : FILE_FLAG_SEQUENTIAL_SCAN;
+
+    return CreateFileW(path.c_str(), GENERIC_READ, options.shareMode, NULL, OPEN_EXISTING, flags, NULL);
+}
+
+CyberlibsCore::FileReader::Status CyberlibsCore::FileReader::Stream(HANDLE hFile, const Options& options,
+                                                                    const Consumer& consumer)
+{
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(hFile, &fileSize))
+    {
+        return Status::ReadFailed;
+    }
+
+    const uint64_t size = static_cast<uint64_t>(fileSize.QuadPart);
+    const uint64_t begin = (std::min)(options.offset, size);
+    const uint64_t end = options.length >= size - begin ? size : begin + options.length;
+    if (begin == end)
+    {
+        return Status::Ok;
+    }
+
+    auto isCancelled = [&options]()
+    {
+        return (options.job && options.job->IsCancelled()) ||
+               (options.abort && options.abort->load(std::memory_order_relaxed));
+    };
+
+    if (isCancelled())
+    {
+        return Status::Cancelled;
+    }
+
+    ReadPipeline pipeline(hFile);
+    if (!pipeline.Initialize())
+    {
+        return Status::ReadFailed;
+    }
+
+    // Offsets and lengths stay sector-aligned so the same pipeline works with FILE_FLAG_NO_BUFFERING.
+    uint64_t nextRead = begin & ~static_cast<uint64_t>(SECTOR_ALIGNMENT - 1);
+
+    auto issueRead = [&](ReadSlot& slot) -> bool
+    {
+        if (nextRead >= end)
+        {
+            return true;
+        }
+
+        uint64_t remaining = end - nextRead;
+        uint64_t alignedRemaining = (remaining + SECTOR_ALIGNMENT - 1) & ~static_cast<uint64_t>(SECTOR_ALIGNMENT - 1);
+        DWORD toRead = static_cast<DWORD>((std::min)(static_cast<uint64_t>(BLOCK_SIZE), alignedRemaining));
+
+        HANDLE hEvent = slot.overlapped.hEvent;
+        ZeroMemory(&slot.overlapped, sizeof(OVERLAPPED));
+        slot.overlapped.hEvent = hEvent;
+        slot.overlapped.Offset = static_cast<DWORD>(nextRead & 0xFFFFFFFF);
+        slot.overlapped.OffsetHigh = static_cast<DWORD>(nextRead >> 32);
+        slot.position = nextRead;
+        ResetEvent(hEvent);
+
+        if (!ReadFile(hFile, slot.data, toRead, NULL, &slot.overlapped))
+        {
+            DWORD error = GetLastError();
+            if (error == ERROR_HANDLE_EOF)
+            {
+                nextRead = end;
+                return true;
+            }
+
+            if (error != ERROR_IO_PENDING)
+            {
+                return false;
+            }
+        }
+
+        slot.pending = true;
+        nextRead += toRead;
+
+        return true;
+    };
+
+    for (auto& slot : pipeline.slots)
+    {
+        if (!issueRead(slot))
+        {
+            return Status::ReadFailed;
+        }
+    }
+
+    size_t current = 0;
+    while (pipeline.slots[current].pending)
+    {
+        ReadSlot& slot = pipeline.slots[current];
+        DWORD bytesRead = 0;
+        BOOL completed = GetOverlappedResult(hFile, &slot.overlapped, &bytesRead, TRUE);
+        slot.pending = false;
+
+        if (!completed && GetLastError() != ERROR_HANDLE_EOF)
+        {
+            return Status::ReadFailed;
+        }
+
+        uint64_t dataBegin = (std::max)(slot.position, begin);
+        uint64_t dataEnd = (std::min)(slot.position + bytesRead, end);
+        if (dataEnd > dataBegin &&
+            !consumer(slot.data + (dataBegin - slot.position), static_cast<size_t>(dataEnd - dataBegin)))
+        {
+            return Status::Cancelled;
+        }
+
+        if (options.job)
+        {
+            options.job->AddBytes(dataEnd > dataBegin ? dataEnd - dataBegin : 0);
+        }
+
+        if (isCancelled())
+        {
+            return Status::Cancelled;
+        }
+
+        // A short read means the file ended early (or shrank since it was opened), nothing more to queue.
+        if (slot.position + bytesRead < (std::min)(slot.position + BLOCK_SIZE, end))
+        {
+            nextRead = end;
+        }
+
+        if (!issueRead(slot))
+        {
+            return Status::ReadFailed;
+        }
+
+        current = (current + 1) % BLOCK_COUNT;
+    }
+
+    return Status::Ok;
+}
+
+CyberlibsCore::FileReader::Status CyberlibsCore::FileReader::HashFile(const std::filesystem::path& path,
+                                                                      const Options& options, std::string& hexDigest)
+{
+    struct sha256_buff sha_buff;
+    sha256_init(&sha_buff);
+
+    auto status = Stream(path, options,
+                         [&sha_buff](const uint8_t* data, size_t size) -> bool
+                         {
+                             sha256_update(&sha_buff, data, size);
+                             return true;
+                         });
+
+    if (status != Status::Ok)
+    {
+        return status;
+    }
+
+    sha256_finalize(&sha_buff);
+    char hashStr[65] = {0};
+    sha256_read_hex(&sha_buff, hashStr);
+    hexDigest = hashStr;
+
+    return Status::Ok;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <windows.h>
+#include <sha256.h>
+#include "DiagnosticsJobs.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <string>
+
+namespace CyberlibsCore
+{
+class FileReader
+{
+public:
+    enum class Status
+    {
+        Ok,
+        OpenFailed,
+        ReadFailed,
+        Cancelled
+    };
+
+    struct Options
+    {
+        // Opens the file with FILE_FLAG_NO_BUFFERING, so reading huge archives does not evict the game's own data
+        // from the system file cache.
+        bool bypassCache = false;
+        DWORD shareMode = FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE;
+        uint64_t offset = 0;
+        uint64_t length = UINT64_MAX;
+        // Receives read progress and stops the read once cancelled.
+        DiagnosticsJob* job = nullptr;
+        // Set from another thread to abandon the read, e.g. once a sibling task has failed. Ends as Cancelled.
+        const std::atomic<bool>* abort = nullptr;
+    };
+
+    // Receives consecutive slices of the requested byte range. Returning false stops the read.
+    using Consumer = std::function<bool(const uint8_t* data, size_t size)>;
+
+    static constexpr size_t BLOCK_SIZE = 1024 * 1024;
+    static constexpr size_t BLOCK_COUNT = 3;
+    static constexpr size_t SECTOR_ALIGNMENT = 4096;
+
+    static Status Stream(const std::filesystem::path& path, const Options& options, const Consumer& consumer);
+    // Opens path for Stream(HANDLE, ...), so several ranges of one file can be read, also concurrently, through a
+    // single handle. Returns INVALID_HANDLE_VALUE on failure; the caller closes the handle.
+    static HANDLE Open(const std::filesystem::path& path, const Options& options);
+    // file must come from Open with the same bypassCache setting.
+    static Status Stream(HANDLE file, const Options& options, const Consumer& consumer);
+    static Status HashFile(const std::filesystem::path& path, const Options& options, std::string& hexDigest);
+};
+} // namespace CyberlibsCore
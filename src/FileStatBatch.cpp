@@ -0,0 +1,112 @@
+#include "FileStatBatch.hpp"
+#include "GameSandbox.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <unordered_map>
+
+void CyberlibsCore::FileStatBatch::Query(const std::filesystem::path& root,
+                                         const std::vector<std::string_view>& paths, uint32_t maxThreads,
+                                         std::vector<Result>& results)
+{
+    results.assign(paths.size(), Result{});
+
+    std::vector<DirectoryGroup> groups;
+    std::unordered_map<std::wstring, size_t> groupIndices;
+
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        std::filesystem::path fullPath;
+        std::wstring name;
+        if (!DirectoryScanner::Resolve(root, paths[i], fullPath, name))
+        {
+            continue;
+        }
+
+        results[i].isSafe = true;
+        if (name.empty())
+        {
+            // The root has no parent listing to be found in.
+            results[i].exists = true;
+            results[i].info.attributes = FILE_ATTRIBUTE_DIRECTORY;
+            continue;
+        }
+
+        std::filesystem::path directory = fullPath.parent_path();
+        auto [it, inserted] = groupIndices.try_emplace(DirectoryScanner::FoldCase(directory.wstring()), groups.size());
+        if (inserted)
+        {
+            // Checked once per directory; entries that are links themselves are checked once they are found.
+            bool isSafe = GameSandbox::ContainsDirectory(directory);
+            groups.push_back({std::move(directory), isSafe, {}});
+        }
+
+        groups[it->second].targets.push_back({i, std::move(name), fullPath.filename()});
+    }
+
+    WorkStealingPool::Run(groups.size(), maxThreads,
+                          [&](size_t index)
+                          {
+                              const auto& group = groups[index];
+                              if (!group.isSafe)
+                              {
+                                  for (const auto& target : group.targets)
+                                  {
+                                      results[target.index].isSafe = false;
+                                  }
+
+                                  return;
+                              }
+
+                              if (group.targets.size() < LISTING_THRESHOLD)
+                              {
+                                  // Listing a mod folder of thousands of archives to answer one question costs
+                                  // more than asking directly.
+                                  for (const auto& target : group.targets)
+                                  {
+                                      queryAttributes(group.directory / target.path, results[target.index]);
+                                  }
+                              }
+                              else
+                              {
+                                  DirectoryScanner::Listing listing;
+                                  DirectoryScanner::List(group.directory, listing);
+
+                                  for (const auto& target : group.targets)
+                                  {
+                                      auto entry = listing.find(target.name);
+                                      if (entry != listing.end())
+                                      {
+                                          results[target.index].exists = true;
+                                          results[target.index].info = entry->second;
+                                      }
+                                  }
+                              }
+
+                              for (const auto& target : group.targets)
+                              {
+                                  auto& result = results[target.index];
+                                  if (result.exists && (result.info.attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0 &&
+                                      !GameSandbox::Contains(group.directory / target.path))
+                                  {
+                                      result = Result{};
+                                  }
+                              }
+                          });
+}
+
+// Private Helpers
+
+void CyberlibsCore::FileStatBatch::queryAttributes(const std::filesystem::path& path, Result& result)
+{
+    WIN32_FILE_ATTRIBUTE_DATA fileInfo;
+    if (!GetFileAttributesExW(path.c_str(), GetFileExInfoStandard, &fileInfo))
+    {
+        return;
+    }
+
+    result.exists = true;
+    result.info.size = (static_cast<uint64_t>(fileInfo.nFileSizeHigh) << 32) | fileInfo.nFileSizeLow;
+    result.info.lastWriteTime = (static_cast<uint64_t>(fileInfo.ftLastWriteTime.dwHighDateTime) << 32) |
+                                fileInfo.ftLastWriteTime.dwLowDateTime;
+    result.info.attributes = fileInfo.dwFileAttributes;
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "DirectoryScanner.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Answers existence and metadata questions for many paths at once. Paths are grouped by parent directory, each
+// directory is listed once (or queried path by path when only a few of its entries are wanted), and independent
+// directories are handled in parallel. root is the game directory; anything GameSandbox does not contain is
+// reported as unsafe.
+class FileStatBatch
+{
+public:
+    struct Result
+    {
+        // False for paths that would leave the root, lexically or through a link; such paths are never read.
+        bool isSafe;
+        bool exists;
+        DirectoryScanner::Entry info;
+    };
+
+    // paths are UTF-8 and relative to root. results[i] answers paths[i].
+    static void Query(const std::filesystem::path& root, const std::vector<std::string_view>& paths,
+                      uint32_t maxThreads, std::vector<Result>& results);
+
+private:
+    // Directories with fewer queried paths than this are answered with one attribute query per path instead of a
+    // full listing.
+    static constexpr size_t LISTING_THRESHOLD = 4;
+
+    struct Target
+    {
+        size_t index;
+        // Case-folded, for listing lookups.
+        std::wstring name;
+        std::filesystem::path path;
+    };
+
+    struct DirectoryGroup
+    {
+        std::filesystem::path directory;
+        bool isSafe;
+        std::vector<Target> targets;
+    };
+
+    static void queryAttributes(const std::filesystem::path& path, Result& result);
+};
+} // namespace CyberlibsCore
@@ -1,5 +1,82 @@
 #include "GameDiagnostics.hpp"
 
+void CyberlibsCore::GameDiagnostics::AddKnowledgeBasePath(const Red::CString& modName,
+                                                          const Red::CString& relativeFilePath)
+{
+    KnowledgeBaseIndex::Add(modName.c_str(), relativeFilePath.c_str());
+}
+
+void CyberlibsCore::GameDiagnostics::BeginInstallSession()
+{
+    // Walking the mod folders takes a while on large installs, so the baseline is captured at idle priority while
+    // the game loads instead of holding up plugin startup.
+    DiagnosticsScheduler::Submit(DiagnosticsScheduler::Priority::Idle,
+                                 []() -> void
+                                 {
+                                     try
+                                     {
+                                         auto gamePath = GetGamePath();
+                                         std::filesystem::path statePath = getOutputPath(InstallState::STATE_PATH);
+                                         if (gamePath.Length() == 0 || statePath.empty() ||
+                                             !ensureDirectoryExists(statePath.parent_path()))
+                                         {
+                                             return;
+                                         }
+
+                                         startTreeCache(gamePath);
+                                         InstallState::BeginSession(
+                                             std::filesystem::path(gamePath.c_str()).lexically_normal(), statePath,
+                                             DiagnosticsScheduler::ThreadBudget(0));
+                                     }
+                                     catch (const std::exception&)
+                                     {
+                                     }
+                                 });
+}
+
+bool CyberlibsCore::GameDiagnostics::CloseFollow(uint64_t handle)
+{
+    return LogFollower::Close(handle);
+}
+
+Red::DynArray<CyberlibsCore::GameDiagnosticsInstallChange> CyberlibsCore::GameDiagnostics::DiffInstallState()
+{
+    Red::DynArray<GameDiagnosticsInstallChange> result;
+
+    try
+    {
+        // Both sides were captured when the session started, so nothing is read here; a fresh, hashed comparison
+        // is GameDiagnosticsAsync::DiffInstallState.
+        std::vector<InstallState::Difference> differences;
+        if (!InstallState::GetSessionChanges(differences))
+        {
+            return result;
+        }
+
+        result.Reserve(static_cast<uint32_t>(differences.size()));
+        for (const auto& difference : differences)
+        {
+            GameDiagnosticsInstallChange change;
+            change.path = Red::CString(difference.path.c_str());
+            change.change = Red::CString(InstallState::ToString(difference.change));
+            change.sizeBefore = difference.sizeBefore;
+            change.sizeAfter = difference.sizeAfter;
+            result.PushBack(change);
+        }
+    }
+    catch (const std::exception&)
+    {
+        result.Clear();
+    }
+
+    return result;
+}
+
+bool CyberlibsCore::GameDiagnostics::FlushOutput()
+{
+    return OutputSink::Flush();
+}
+
 Red::CString CyberlibsCore::GameDiagnostics::GetCurrentTimeDate(Red::Optional<bool> pathFriendly)
 {
     auto now = std::chrono::system_clock::now();
@@ -20,7 +97,8 @@ Red::CString CyberlibsCore::GameDiagnostics::GetCurrentTimeDate(Red::Optional<bo
     return Red::CString(ss.str().c_str());
 }
 
-Red::CString CyberlibsCore::GameDiagnostics::GetFileHash(const Red::CString& relativeFilePath)
+Red::CString CyberlibsCore::GameDiagnostics::GetFileHash(const Red::CString& relativeFilePath,
+                                                         Red::Optional<bool> bypassCache)
 {
     try
     {
@@ -33,45 +111,26 @@ Red::CString CyberlibsCore::GameDiagnostics::GetFileHash(const Red::CString& rel
         std::string normalizedPath = normalizePathString(relativeFilePath);
         std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
         fullPath = fullPath.lexically_normal();
-        if (!isPathSafe(fullPath) || !std::filesystem::exists(fullPath) || !std::filesystem::is_regular_file(fullPath))
+        if (!GameSandbox::Contains(fullPath) || !std::filesystem::exists(fullPath) ||
+            !std::filesystem::is_regular_file(fullPath))
         {
             return UNKNOWN_VALUE;
         }
 
-        HANDLE hFile = CreateFileW(fullPath.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
-                                   FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        FileReader::Options readOptions;
+        readOptions.bypassCache = bypassCache;
+        readOptions.shareMode = FILE_SHARE_READ;
 
-        if (hFile == INVALID_HANDLE_VALUE)
+        std::string hash;
+        switch (FileReader::HashFile(fullPath, readOptions, hash))
         {
+        case FileReader::Status::Ok:
+            return Red::CString(hash.c_str());
+        case FileReader::Status::OpenFailed:
             return FILE_LOCKED;
+        default:
+            return FILE_READ_FAIL;
         }
-
-        std::unique_ptr<void, decltype(&CloseHandle)> fileGuard(hFile, CloseHandle);
-        struct sha256_buff sha_buff;
-        sha256_init(&sha_buff);
-        uint8_t buffer[8192];
-        DWORD bytesRead = 0;
-
-        while (true)
-        {
-            if (!ReadFile(hFile, buffer, sizeof(buffer), &bytesRead, NULL))
-            {
-                return FILE_READ_FAIL;
-            }
-
-            if (bytesRead == 0)
-            {
-                break;
-            }
-
-            sha256_update(&sha_buff, buffer, bytesRead);
-        }
-
-        sha256_finalize(&sha_buff);
-        char hashStr[65] = {0};
-        sha256_read_hex(&sha_buff, hashStr);
-
-        return Red::CString(hashStr);
     }
     catch (const std::exception& e)
     {
@@ -85,16 +144,12 @@ Red::CString CyberlibsCore::GameDiagnostics::GetGamePath()
 {
     try
     {
-        wchar_t path[32768];
-        DWORD length = GetModuleFileNameW(NULL, path, sizeof(path) / sizeof(wchar_t));
-        if (length == 0 || length >= sizeof(path) / sizeof(wchar_t))
+        const auto& gamePath = GameSandbox::Root();
+        if (gamePath.empty())
         {
             return INVALID_GAME_PATH;
         }
 
-        std::filesystem::path gamePath = std::filesystem::path(path).lexically_normal();
-        gamePath = gamePath.parent_path().parent_path().parent_path();
-
         return Red::CString(gamePath.string().c_str());
     }
     catch (const std::exception& e)
@@ -105,6 +160,24 @@ Red::CString CyberlibsCore::GameDiagnostics::GetGamePath()
     }
 }
 
+int32_t CyberlibsCore::GameDiagnostics::GetLineCount(const Red::CString& relativeFilePath)
+{
+    try
+    {
+        LineReader reader;
+        if (!openTextFile(relativeFilePath, reader))
+        {
+            return -1;
+        }
+
+        return static_cast<int32_t>(std::min<size_t>(reader.LineCount(), INT32_MAX));
+    }
+    catch (const std::exception&)
+    {
+        return -1;
+    }
+}
+
 Red::CString CyberlibsCore::GameDiagnostics::GetTimeDateStamp(const Red::CString& relativeFilePath,
                                                               Red::Optional<bool> pathFriendly)
 {
@@ -119,7 +192,7 @@ Red::CString CyberlibsCore::GameDiagnostics::GetTimeDateStamp(const Red::CString
         std::string normalizedPath = normalizePathString(relativeFilePath);
         std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
         fullPath = fullPath.lexically_normal();
-        if (!isPathSafe(fullPath))
+        if (!GameSandbox::Contains(fullPath))
         {
             return UNKNOWN_VALUE;
         }
@@ -163,6 +236,101 @@ Red::CString CyberlibsCore::GameDiagnostics::GetTimeDateStamp(const Red::CString
     }
 }
 
+uint64_t CyberlibsCore::GameDiagnostics::GetTreeGeneration()
+{
+    try
+    {
+        auto gamePath = GetGamePath();
+        if (gamePath.Length() == 0)
+        {
+            return 0;
+        }
+
+        startTreeCache(gamePath);
+
+        return DirectoryTreeCache::GetGeneration();
+    }
+    catch (const std::exception&)
+    {
+        return 0;
+    }
+}
+
+bool CyberlibsCore::GameDiagnostics::HasChangedSince(const Red::CString& relativePath, uint64_t generation)
+{
+    try
+    {
+        auto gamePath = GetGamePath();
+        if (gamePath.Length() == 0)
+        {
+            return true;
+        }
+
+        std::string normalizedPath = normalizePathString(relativePath);
+        std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
+        fullPath = fullPath.lexically_normal();
+        if (!GameSandbox::Contains(fullPath))
+        {
+            return true;
+        }
+
+        startTreeCache(gamePath);
+
+        return DirectoryTreeCache::HasChangedSince(fullPath, generation);
+    }
+    catch (const std::exception&)
+    {
+        return true;
+    }
+}
+
+bool CyberlibsCore::GameDiagnostics::HasInstallState()
+{
+    try
+    {
+        std::vector<InstallState::Difference> differences;
+
+        return InstallState::GetSessionChanges(differences);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+Red::DynArray<Red::CString> CyberlibsCore::GameDiagnostics::IdentifyPaths(
+    const Red::DynArray<Red::CString>& relativeFilePaths)
+{
+    Red::DynArray<Red::CString> result;
+
+    try
+    {
+        auto gamePath = GetGamePath();
+        if (gamePath.Length() != 0)
+        {
+            KnowledgeBaseIndex::Load(std::filesystem::path(gamePath.c_str()) / KNOWLEDGE_BASE_PATH);
+        }
+
+        std::vector<std::string_view> paths;
+        paths.reserve(relativeFilePaths.size);
+        for (const auto& path : relativeFilePaths)
+        {
+            paths.emplace_back(path.c_str(), path.Length());
+        }
+
+        for (const auto& name : KnowledgeBaseIndex::Identify(paths))
+        {
+            result.PushBack(Red::CString(name.c_str()));
+        }
+    }
+    catch (const std::exception&)
+    {
+        result.Clear();
+    }
+
+    return result;
+}
+
 bool CyberlibsCore::GameDiagnostics::IsFile(const Red::CString& relativeFilePath)
 {
     try
@@ -177,7 +345,8 @@ bool CyberlibsCore::GameDiagnostics::IsFile(const Red::CString& relativeFilePath
         std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
         fullPath = fullPath.lexically_normal();
 
-        return isPathSafe(fullPath) && std::filesystem::exists(fullPath) && std::filesystem::is_regular_file(fullPath);
+        return GameSandbox::Contains(fullPath) && std::filesystem::exists(fullPath) &&
+               std::filesystem::is_regular_file(fullPath);
     }
     catch (const std::exception&)
     {
@@ -199,7 +368,8 @@ bool CyberlibsCore::GameDiagnostics::IsDirectory(const Red::CString& relativePat
         std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
         fullPath = fullPath.lexically_normal();
 
-        return isPathSafe(fullPath) && std::filesystem::exists(fullPath) && std::filesystem::is_directory(fullPath);
+        return GameSandbox::Contains(fullPath) && std::filesystem::exists(fullPath) &&
+               std::filesystem::is_directory(fullPath);
     }
     catch (const std::exception&)
     {
@@ -208,7 +378,7 @@ bool CyberlibsCore::GameDiagnostics::IsDirectory(const Red::CString& relativePat
 }
 
 Red::DynArray<CyberlibsCore::GameDiagnosticsPathEntry> CyberlibsCore::GameDiagnostics::ListDirectory(
-    const Red::CString& relativePath)
+    const Red::CString& relativePath, Red::Optional<Red::CString> sortBy, Red::Optional<bool> descending)
 {
     Red::DynArray<GameDiagnosticsPathEntry> result;
 
@@ -223,18 +393,94 @@ Red::DynArray<CyberlibsCore::GameDiagnosticsPathEntry> CyberlibsCore::GameDiagno
         std::string normalizedPath = normalizePathString(relativePath);
         std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
         fullPath = fullPath.lexically_normal();
-        if (!isPathSafe(fullPath) || !std::filesystem::exists(fullPath) || !std::filesystem::is_directory(fullPath))
+        if (!GameSandbox::Contains(fullPath))
+        {
+            return result;
+        }
+
+        struct Item
+        {
+            std::wstring foldedName;
+            std::string name;
+            std::string extension;
+            DirectoryScanner::Entry info;
+        };
+
+        startTreeCache(gamePath);
+
+        // One large-fetch enumeration already carries everything a caller would otherwise ask for per entry.
+        std::vector<Item> items;
+        bool listed = DirectoryTreeCache::Enumerate(
+            fullPath,
+            [&items](std::wstring&& name, const DirectoryScanner::Entry& info)
+            {
+                Item item;
+                auto utf8Name = std::filesystem::path(name).u8string();
+                item.name.assign(utf8Name.begin(), utf8Name.end());
+                if (!info.IsDirectory())
+                {
+                    auto utf8Extension = std::filesystem::path(name).extension().u8string();
+                    item.extension.assign(utf8Extension.begin(), utf8Extension.end());
+                    std::transform(item.extension.begin(), item.extension.end(), item.extension.begin(),
+                                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+                }
+
+                item.foldedName = DirectoryScanner::FoldCase(std::move(name));
+                item.info = info;
+                items.push_back(std::move(item));
+            });
+        if (!listed)
         {
             return result;
         }
 
-        for (const auto& entry : std::filesystem::directory_iterator(fullPath))
+        std::string sortKey = static_cast<const Red::CString&>(sortBy).c_str();
+        auto byName = [](const Item& a, const Item& b) { return a.foldedName < b.foldedName; };
+        std::function<bool(const Item&, const Item&)> less;
+        if (sortKey == "name")
+        {
+            less = byName;
+        }
+        else if (sortKey == "extension")
+        {
+            less = [&byName](const Item& a, const Item& b)
+            { return a.extension != b.extension ? a.extension < b.extension : byName(a, b); };
+        }
+        else if (sortKey == "size")
+        {
+            less = [&byName](const Item& a, const Item& b)
+            { return a.info.size != b.info.size ? a.info.size < b.info.size : byName(a, b); };
+        }
+        else if (sortKey == "lastWriteTime")
+        {
+            less = [&byName](const Item& a, const Item& b) {
+                return a.info.lastWriteTime != b.info.lastWriteTime ? a.info.lastWriteTime < b.info.lastWriteTime
+                                                                    : byName(a, b);
+            };
+        }
+
+        if (less)
+        {
+            if (descending)
+            {
+                std::sort(items.begin(), items.end(), [&less](const Item& a, const Item& b) { return less(b, a); });
+            }
+            else
+            {
+                std::sort(items.begin(), items.end(), less);
+            }
+        }
+
+        result.Reserve(static_cast<uint32_t>(items.size()));
+        for (const auto& item : items)
         {
             GameDiagnosticsPathEntry dirEntry;
-            std::string entryPath = entry.path().filename().string();
-            std::replace(entryPath.begin(), entryPath.end(), '\\', '/');
-            dirEntry.name = Red::CString(entryPath.c_str());
-            dirEntry.type = entry.is_directory() ? Red::CString("dir") : Red::CString("file");
+            dirEntry.name = Red::CString(item.name.c_str());
+            dirEntry.type = item.info.IsDirectory() ? Red::CString("dir") : Red::CString("file");
+            dirEntry.extension = Red::CString(item.extension.c_str());
+            dirEntry.size = item.info.size;
+            dirEntry.lastWriteTime = fileTimeToUnixSeconds(item.info.lastWriteTime);
+            dirEntry.attributes = item.info.attributes;
             result.PushBack(dirEntry);
         }
     }
@@ -246,6 +492,121 @@ Red::DynArray<CyberlibsCore::GameDiagnosticsPathEntry> CyberlibsCore::GameDiagno
     return result;
 }
 
+uint64_t CyberlibsCore::GameDiagnostics::OpenFollow(const Red::CString& relativeFilePath,
+                                                    Red::Optional<bool> fromStart)
+{
+    try
+    {
+        std::filesystem::path fullPath;
+        if (!resolveTextFile(relativeFilePath, fullPath))
+        {
+            return 0;
+        }
+
+        return LogFollower::Open(fullPath, fromStart);
+    }
+    catch (const std::exception&)
+    {
+        return 0;
+    }
+}
+
+Red::DynArray<CyberlibsCore::GameDiagnosticsArchiveInfo> CyberlibsCore::GameDiagnostics::ReadArchiveIndexes(
+    const Red::DynArray<Red::CString>& relativePaths, Red::Optional<bool> includeResources)
+{
+    Red::DynArray<GameDiagnosticsArchiveInfo> result;
+
+    try
+    {
+        LoadArchiveIndexes(relativePaths, includeResources, result);
+    }
+    catch (const std::exception&)
+    {
+        result.Clear();
+    }
+
+    return result;
+}
+
+Red::DynArray<Red::CString> CyberlibsCore::GameDiagnostics::ReadLines(const Red::CString& relativeFilePath,
+                                                                      int32_t start, int32_t count)
+{
+    Red::DynArray<Red::CString> result;
+
+    try
+    {
+        LineReader reader;
+        if (start < 0 || count <= 0 || !openTextFile(relativeFilePath, reader))
+        {
+            return result;
+        }
+
+        size_t begin = std::min<size_t>(static_cast<size_t>(start), reader.LineCount());
+        size_t end = std::min<size_t>(begin + static_cast<size_t>(count), reader.LineCount());
+
+        result.Reserve(static_cast<uint32_t>(end - begin));
+        for (size_t i = begin; i < end; ++i)
+        {
+            result.PushBack(toScriptString(reader.Line(i)));
+        }
+    }
+    catch (const std::exception&)
+    {
+        result.Clear();
+    }
+
+    return result;
+}
+
+Red::DynArray<Red::CString> CyberlibsCore::GameDiagnostics::ReadTail(const Red::CString& relativeFilePath,
+                                                                     int32_t count)
+{
+    Red::DynArray<Red::CString> result;
+
+    try
+    {
+        LineReader reader;
+        if (count <= 0 || !openTextFile(relativeFilePath, reader))
+        {
+            return result;
+        }
+
+        size_t end = reader.LineCount();
+        size_t begin = end - std::min<size_t>(static_cast<size_t>(count), end);
+
+        result.Reserve(static_cast<uint32_t>(end - begin));
+        for (size_t i = begin; i < end; ++i)
+        {
+            result.PushBack(toScriptString(reader.Line(i)));
+        }
+    }
+    catch (const std::exception&)
+    {
+        result.Clear();
+    }
+
+    return result;
+}
+
+CyberlibsCore::GameDiagnosticsFollowRead CyberlibsCore::GameDiagnostics::ReadNew(uint64_t handle)
+{
+    GameDiagnosticsFollowRead result;
+
+    try
+    {
+        std::string text;
+        auto status = LogFollower::ReadNew(handle, text);
+        result.text = toScriptString(text);
+        result.status = Red::CString(LogFollower::ToString(status));
+    }
+    catch (const std::exception&)
+    {
+        result.status = Red::CString(LogFollower::ToString(LogFollower::Status::Missing));
+    }
+
+    return result;
+}
+
 Red::CString CyberlibsCore::GameDiagnostics::ReadTextFile(const Red::CString& relativeFilePath)
 {
     try
@@ -259,7 +620,7 @@ Red::CString CyberlibsCore::GameDiagnostics::ReadTextFile(const Red::CString& re
         std::string normalizedPath = normalizePathString(relativeFilePath);
         std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
         fullPath = fullPath.lexically_normal();
-        if (!isPathSafe(fullPath) || !std::filesystem::exists(fullPath) ||
+        if (!GameSandbox::Contains(fullPath) || !std::filesystem::exists(fullPath) ||
             !std::filesystem::is_regular_file(fullPath) || !isTextFile(fullPath))
         {
             return UNKNOWN_VALUE;
@@ -276,7 +637,7 @@ Red::CString CyberlibsCore::GameDiagnostics::ReadTextFile(const Red::CString& re
         std::unique_ptr<void, decltype(&CloseHandle)> fileGuard(hFile, CloseHandle);
 
         LARGE_INTEGER fileSize;
-        if (!GetFileSizeEx(hFile, &fileSize) || fileSize.QuadPart > MAX_OUTPUT_FILE_SIZE)
+        if (!GetFileSizeEx(hFile, &fileSize) || static_cast<uint64_t>(fileSize.QuadPart) > MAX_INPUT_FILE_SIZE)
         {
             return FILE_READ_FAIL;
         }
@@ -292,7 +653,7 @@ Red::CString CyberlibsCore::GameDiagnostics::ReadTextFile(const Red::CString& re
 
         fileGuard.reset();
 
-        if (!isValidUtf8(content))
+        if (!TextEncoding::ToUtf8(content))
         {
             return FILE_READ_FAIL;
         }
@@ -307,90 +668,226 @@ Red::CString CyberlibsCore::GameDiagnostics::ReadTextFile(const Red::CString& re
     }
 }
 
-bool CyberlibsCore::GameDiagnostics::VerifyPaths(const Red::CString& relativePathsFilePath)
+bool CyberlibsCore::GameDiagnostics::SaveInstallState()
 {
     try
     {
         auto gamePath = GetGamePath();
-        if (gamePath.Length() == 0)
+        std::filesystem::path statePath = getOutputPath(InstallState::STATE_PATH);
+        if (gamePath.Length() == 0 || statePath.empty() || !ensureDirectoryExists(statePath.parent_path()))
         {
             return false;
         }
 
-        std::string normalizedInputPath = relativePathsFilePath.c_str();
-        std::replace(normalizedInputPath.begin(), normalizedInputPath.end(), '\\', '/');
-        std::filesystem::path inputPath = std::filesystem::path(gamePath.c_str()) / normalizedInputPath;
-        inputPath = inputPath.lexically_normal();
-        if (!isPathSafe(inputPath) || !std::filesystem::exists(inputPath) ||
-            !std::filesystem::is_regular_file(inputPath))
+        // A missing or unreadable previous state only means no hashes are carried over.
+        std::vector<InstallState::Entry> previous;
+        InstallState::Load(statePath, previous);
+
+        startTreeCache(gamePath);
+
+        std::vector<InstallState::Entry> current;
+        InstallState::Capture(std::filesystem::path(gamePath.c_str()).lexically_normal(), &previous, false,
+                              DiagnosticsScheduler::ThreadBudget(0), current);
+
+        return InstallState::Save(statePath, current);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+Red::DynArray<CyberlibsCore::GameDiagnosticsSearchMatch> CyberlibsCore::GameDiagnostics::SearchFile(
+    const Red::CString& relativeFilePath, const Red::CString& needle, const GameDiagnosticsSearchOptions& options)
+{
+    Red::DynArray<GameDiagnosticsSearchMatch> result;
+
+    try
+    {
+        LineSearch search;
+        LineSearch::Options searchOptions;
+        searchOptions.ignoreCase = options.ignoreCase;
+        searchOptions.regex = options.regex;
+
+        LineReader reader;
+        if (!search.Compile(needle.c_str(), searchOptions) || !openTextFile(relativeFilePath, reader))
         {
-            return false;
+            return result;
+        }
+
+        std::vector<size_t> lines;
+        search.Search(reader, options.maxMatches > 0 ? static_cast<size_t>(options.maxMatches) : SIZE_MAX, lines);
+        appendMatches(reader, lines, Red::CString(normalizePathString(relativeFilePath).c_str()),
+                      options.contextLines, result);
+    }
+    catch (const std::exception&)
+    {
+        result.Clear();
+    }
+
+    return result;
+}
+
+Red::DynArray<CyberlibsCore::GameDiagnosticsSearchMatch> CyberlibsCore::GameDiagnostics::SearchFiles(
+    const Red::CString& relativePath, const Red::CString& include, const Red::CString& needle,
+    const GameDiagnosticsSearchOptions& options)
+{
+    Red::DynArray<GameDiagnosticsSearchMatch> result;
+
+    try
+    {
+        auto gamePath = GetGamePath();
+        if (gamePath.Length() == 0)
+        {
+            return result;
         }
 
-        auto fileSize = std::filesystem::file_size(inputPath);
-        if (fileSize > MAX_INPUT_FILE_SIZE)
+        std::string normalizedPath = normalizePathString(relativePath);
+        std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
+        fullPath = fullPath.lexically_normal();
+        if (!GameSandbox::Contains(fullPath))
         {
-            return false;
+            return result;
         }
 
-        auto extension = inputPath.extension().string();
-        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
-        if (extension != ".paths")
+        LineSearch search;
+        LineSearch::Options searchOptions;
+        searchOptions.ignoreCase = options.ignoreCase;
+        searchOptions.regex = options.regex;
+
+        DirectoryWalker::Options walkOptions;
+        walkOptions.includeDirectories = false;
+        walkOptions.maxThreads = DiagnosticsScheduler::ThreadBudget(0);
+        GlobPattern glob;
+        if (!search.Compile(needle.c_str(), searchOptions) || !glob.Compile(include.c_str()))
         {
-            return false;
+            return result;
         }
 
-        std::ifstream file(inputPath, std::ios::binary);
-        if (!file.is_open())
+        walkOptions.include.push_back(std::move(glob));
+
+        startTreeCache(gamePath);
+
+        std::vector<DirectoryWalker::Entry> entries;
+        if (!DirectoryWalker::Walk(fullPath, walkOptions, entries))
         {
-            return false;
+            return result;
+        }
+
+        std::erase_if(entries, [&fullPath](const DirectoryWalker::Entry& entry)
+                      { return !isTextFile(fullPath / std::filesystem::path(std::u8string(
+                                                          entry.relativePath.begin(), entry.relativePath.end()))); });
+
+        // Each file is mapped, searched and released by one task, so only as many files as there are threads are
+        // mapped at once. Matches are gathered afterwards so they keep the walk's order.
+        size_t maxMatches = options.maxMatches > 0 ? static_cast<size_t>(options.maxMatches) : SIZE_MAX;
+        std::vector<Red::DynArray<GameDiagnosticsSearchMatch>> matches(entries.size());
+        WorkStealingPool::Run(entries.size(), walkOptions.maxThreads,
+                              [&](size_t index)
+                              {
+                                  const auto& relativeFilePath = entries[index].relativePath;
+                                  std::filesystem::path filePath =
+                                      fullPath / std::filesystem::path(std::u8string(relativeFilePath.begin(),
+                                                                                     relativeFilePath.end()));
+                                  LineReader reader;
+                                  if (!reader.Open(filePath))
+                                  {
+                                      return;
+                                  }
+
+                                  std::vector<size_t> lines;
+                                  search.Search(reader, maxMatches, lines);
+                                  appendMatches(reader, lines, Red::CString(relativeFilePath.c_str()),
+                                                options.contextLines, matches[index]);
+                              });
+
+        for (const auto& fileMatches : matches)
+        {
+            for (const auto& match : fileMatches)
+            {
+                result.PushBack(match);
+            }
         }
+    }
+    catch (const std::exception&)
+    {
+        result.Clear();
+    }
+
+    return result;
+}
 
-        std::string fileContent((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-        file.close();
+Red::DynArray<CyberlibsCore::GameDiagnosticsFileStat> CyberlibsCore::GameDiagnostics::StatBatch(
+    const Red::DynArray<Red::CString>& relativePaths)
+{
+    Red::DynArray<GameDiagnosticsFileStat> result;
 
-        if (!isValidUtf8(fileContent))
+    try
+    {
+        auto gamePath = GetGamePath();
+        if (gamePath.Length() == 0)
         {
-            return false;
+            return result;
         }
 
-        auto validations = readPaths(inputPath);
-        if (validations.empty())
+        std::vector<std::string_view> paths;
+        paths.reserve(relativePaths.size);
+        for (const auto& path : relativePaths)
         {
-            return false;
+            paths.emplace_back(path.c_str(), path.Length());
         }
 
-        const std::filesystem::path gameRoot = std::filesystem::path(gamePath.c_str()).lexically_normal();
+        std::vector<FileStatBatch::Result> stats;
+        FileStatBatch::Query(std::filesystem::path(gamePath.c_str()).lexically_normal(), paths,
+                             DiagnosticsScheduler::ThreadBudget(0), stats);
 
-        for (const auto& validation : validations)
+        result.Reserve(static_cast<uint32_t>(stats.size()));
+        for (size_t i = 0; i < stats.size(); ++i)
         {
-            std::string cleanPath = validation.path;
-            std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
-            if (cleanPath.empty() || cleanPath[0] == '#')
+            const auto& stat = stats[i];
+            GameDiagnosticsFileStat fileStat{};
+            fileStat.path = relativePaths[static_cast<uint32_t>(i)];
+            fileStat.exists = stat.exists;
+            if (stat.exists)
             {
-                continue;
+                fileStat.type = stat.info.IsDirectory() ? Red::CString("dir") : Red::CString("file");
+                fileStat.size = stat.info.size;
+                fileStat.lastWriteTime = fileTimeToUnixSeconds(stat.info.lastWriteTime);
+                fileStat.attributes = stat.info.attributes;
             }
 
-            while (!cleanPath.empty() && (cleanPath[0] == '/' || cleanPath[0] == '\\'))
-            {
-                cleanPath = cleanPath.substr(1);
-            }
+            result.PushBack(fileStat);
+        }
+    }
+    catch (const std::exception&)
+    {
+        result.Clear();
+    }
 
-            std::filesystem::path pathToCheck = gameRoot / cleanPath;
-            pathToCheck = pathToCheck.lexically_normal();
-            if (!isPathSafe(pathToCheck))
-            {
-                return false;
-            }
+    return result;
+}
 
-            bool exists = std::filesystem::exists(pathToCheck);
-            if (validation.shouldExist != exists)
-            {
-                return false;
-            }
+bool CyberlibsCore::GameDiagnostics::VerifyPaths(const Red::CString& relativePathsFilePath,
+                                                 Red::Optional<bool> checkSizes,
+                                                 Red::Optional<bool> stopOnFirstMismatch)
+{
+    try
+    {
+        MappedFile pathsFile;
+        std::vector<PathsParser::Record> records;
+        std::filesystem::path gameRoot;
+        if (!LoadPaths(relativePathsFilePath, pathsFile, records, gameRoot))
+        {
+            return false;
         }
 
-        return true;
+        PathsVerifier::Options verifyOptions;
+        verifyOptions.maxThreads = DiagnosticsScheduler::ThreadBudget(0);
+        verifyOptions.verifyHashes = checkSizes;
+        verifyOptions.sizeOnly = true;
+        verifyOptions.stopOnFirstFailure = stopOnFirstMismatch;
+
+        return PathsVerifier::Verify(gameRoot, records, verifyOptions);
     }
     catch (const std::exception&)
     {
@@ -398,55 +895,132 @@ bool CyberlibsCore::GameDiagnostics::VerifyPaths(const Red::CString& relativePat
     }
 }
 
-bool CyberlibsCore::GameDiagnostics::WriteToOutput(const Red::CString& relativeFilePath, const Red::CString& content,
-                                                   Red::Optional<bool> append)
+Red::DynArray<CyberlibsCore::GameDiagnosticsPathsFailure> CyberlibsCore::GameDiagnostics::VerifyPathsReport(
+    const Red::CString& relativePathsFilePath, Red::Optional<bool> checkSizes)
 {
+    Red::DynArray<GameDiagnosticsPathsFailure> report;
+
     try
     {
-        std::string normalizedPath = normalizePathString(relativeFilePath);
-        if (normalizedPath.find('/') == std::string::npos)
+        MappedFile pathsFile;
+        std::vector<PathsParser::Record> records;
+        std::filesystem::path gameRoot;
+        if (!LoadPaths(relativePathsFilePath, pathsFile, records, gameRoot))
         {
-            return false;
+            // An empty report means "everything matched", so an unusable input file has to show up as an entry.
+            GameDiagnosticsPathsFailure failure;
+            failure.path = relativePathsFilePath;
+            failure.line = 0;
+            failure.reason = INVALID_FILE_REASON;
+            report.PushBack(failure);
+
+            return report;
         }
 
-        std::filesystem::path fullPath = getOutputPath(Red::CString(normalizedPath.c_str()));
-        if (fullPath.empty())
+        PathsVerifier::Options verifyOptions;
+        verifyOptions.maxThreads = DiagnosticsScheduler::ThreadBudget(0);
+        verifyOptions.verifyHashes = checkSizes;
+        verifyOptions.sizeOnly = true;
+        verifyOptions.stopOnFirstFailure = false;
+
+        std::vector<PathsVerifier::Failure> failures;
+        PathsVerifier::Verify(gameRoot, records, verifyOptions, &failures);
+        AppendPathsFailures(records, failures, report);
+    }
+    catch (const std::exception&)
+    {
+        report.Clear();
+
+        GameDiagnosticsPathsFailure failure;
+        failure.path = relativePathsFilePath;
+        failure.line = 0;
+        failure.reason = INVALID_FILE_REASON;
+        report.PushBack(failure);
+    }
+
+    return report;
+}
+
+Red::DynArray<CyberlibsCore::GameDiagnosticsWalkEntry> CyberlibsCore::GameDiagnostics::Walk(
+    const Red::CString& relativePath, const GameDiagnosticsWalkOptions& options)
+{
+    Red::DynArray<GameDiagnosticsWalkEntry> result;
+
+    try
+    {
+        auto gamePath = GetGamePath();
+        if (gamePath.Length() == 0)
         {
-            return false;
+            return result;
         }
 
-        if (append && std::filesystem::exists(fullPath))
+        std::string normalizedPath = normalizePathString(relativePath);
+        std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
+        fullPath = fullPath.lexically_normal();
+        if (!GameSandbox::Contains(fullPath))
         {
-            std::error_code ec;
-            auto fileSize = std::filesystem::file_size(fullPath, ec);
-            if (!ec && fileSize + content.Length() > MAX_INPUT_FILE_SIZE)
-            {
-                return false;
-            }
+            return result;
         }
 
-        auto parentPath = fullPath.parent_path();
-        if (!parentPath.empty() && !ensureDirectoryExists(parentPath))
+        DirectoryWalker::Options walkOptions;
+        walkOptions.maxDepth = static_cast<uint32_t>((std::max)(options.maxDepth, 0));
+        walkOptions.includeFiles = !options.dirsOnly;
+        walkOptions.includeDirectories = !options.filesOnly;
+        walkOptions.maxThreads = options.parallel ? DiagnosticsScheduler::ThreadBudget(options.maxThreads) : 1;
+        if (!compileGlobs(options.include, walkOptions.include) || !compileGlobs(options.exclude, walkOptions.exclude))
         {
-            return false;
+            return result;
         }
 
-        std::ios_base::openmode mode = std::ios::out | std::ios::binary;
-        if (append)
+        startTreeCache(gamePath);
+
+        std::vector<DirectoryWalker::Entry> entries;
+        if (!DirectoryWalker::Walk(fullPath, walkOptions, entries))
+        {
+            return result;
+        }
+
+        result.Reserve(static_cast<uint32_t>(entries.size()));
+        for (const auto& entry : entries)
+        {
+            GameDiagnosticsWalkEntry walkEntry;
+            walkEntry.path = Red::CString(entry.relativePath.c_str());
+            walkEntry.name = Red::CString(entry.name.c_str());
+            walkEntry.type = entry.info.IsDirectory() ? Red::CString("dir") : Red::CString("file");
+            walkEntry.depth = static_cast<int32_t>(entry.depth);
+            result.PushBack(walkEntry);
+        }
+    }
+    catch (const std::exception&)
+    {
+        result.Clear();
+    }
+
+    return result;
+}
+
+bool CyberlibsCore::GameDiagnostics::WriteToOutput(const Red::CString& relativeFilePath, const Red::CString& content,
+                                                   Red::Optional<bool> append)
+{
+    try
+    {
+        std::string normalizedPath = normalizePathString(relativeFilePath);
+        if (normalizedPath.find('/') == std::string::npos)
         {
-            mode |= std::ios::app;
+            return false;
         }
 
-        std::ofstream file(fullPath, mode);
-        if (!file.is_open())
+        std::filesystem::path fullPath = getOutputPath(Red::CString(normalizedPath.c_str()));
+        if (fullPath.empty())
         {
             return false;
         }
 
-        file.exceptions(std::ios::badbit | std::ios::failbit);
-        file.write(content.c_str(), content.Length());
+        // Writes are queued and written in batches by the output sink; the file is only touched off this thread.
+        // Overwrites go through the same queue, so they stay ordered with earlier appends to the file.
+        std::string text(content.c_str(), content.Length());
 
-        return !file.fail();
+        return append ? OutputSink::Append(fullPath, std::move(text)) : OutputSink::Replace(fullPath, std::move(text));
     }
     catch (const std::exception&)
     {
@@ -454,8 +1028,141 @@ bool CyberlibsCore::GameDiagnostics::WriteToOutput(const Red::CString& relativeF
     }
 }
 
+bool CyberlibsCore::GameDiagnostics::LoadPaths(const Red::CString& relativePathsFilePath, MappedFile& pathsFile,
+                                               std::vector<PathsParser::Record>& records,
+                                               std::filesystem::path& gameRoot)
+{
+    auto gamePath = GetGamePath();
+    if (gamePath.Length() == 0)
+    {
+        return false;
+    }
+
+    std::string normalizedInputPath = relativePathsFilePath.c_str();
+    std::replace(normalizedInputPath.begin(), normalizedInputPath.end(), '\\', '/');
+    std::filesystem::path inputPath = std::filesystem::path(gamePath.c_str()) / normalizedInputPath;
+    inputPath = inputPath.lexically_normal();
+    if (!GameSandbox::Contains(inputPath) || !std::filesystem::exists(inputPath) ||
+        !std::filesystem::is_regular_file(inputPath))
+    {
+        return false;
+    }
+
+    auto extension = inputPath.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    if (extension != ".paths")
+    {
+        return false;
+    }
+
+    // Saved install states are .paths manifests as well, so they share the cap.
+    if (!pathsFile.Open(inputPath, InstallState::MAX_STATE_SIZE) || !PathsParser::Parse(pathsFile.View(), records) ||
+        records.empty())
+    {
+        return false;
+    }
+
+    gameRoot = std::filesystem::path(gamePath.c_str()).lexically_normal();
+
+    return true;
+}
+
+void CyberlibsCore::GameDiagnostics::AppendPathsFailures(const std::vector<PathsParser::Record>& records,
+                                                         const std::vector<PathsVerifier::Failure>& failures,
+                                                         Red::DynArray<GameDiagnosticsPathsFailure>& report)
+{
+    for (const auto& failure : failures)
+    {
+        const auto& record = records[failure.record];
+        GameDiagnosticsPathsFailure entry;
+        entry.path = Red::CString(std::string(record.path).c_str());
+        entry.line = static_cast<int32_t>(record.line);
+        entry.reason = PathsVerifier::ToString(failure.reason);
+        report.PushBack(entry);
+    }
+}
+
+bool CyberlibsCore::GameDiagnostics::LoadArchiveIndexes(const Red::DynArray<Red::CString>& relativePaths,
+                                                        bool includeResources,
+                                                        Red::DynArray<GameDiagnosticsArchiveInfo>& archives,
+                                                        DiagnosticsJob* job)
+{
+    auto gamePath = GetGamePath();
+    if (gamePath.Length() == 0)
+    {
+        return false;
+    }
+
+    const std::filesystem::path gameRoot = std::filesystem::path(gamePath.c_str()).lexically_normal();
+
+    // Unsafe paths stay empty, which the reader reports as invalid.
+    std::vector<std::filesystem::path> paths(relativePaths.size);
+    for (uint32_t i = 0; i < relativePaths.size; ++i)
+    {
+        std::string normalizedPath = normalizePathString(relativePaths[i]);
+        std::filesystem::path fullPath =
+            (gameRoot / std::filesystem::path(std::u8string(normalizedPath.begin(), normalizedPath.end())))
+                .lexically_normal();
+        if (GameSandbox::Contains(fullPath))
+        {
+            paths[i] = std::move(fullPath);
+        }
+    }
+
+    std::vector<ArchiveIndex::Summary> summaries;
+    ArchiveIndex::ReadMany(paths, includeResources, DiagnosticsScheduler::ThreadBudget(0), summaries, job);
+    if (job && job->IsCancelled())
+    {
+        return true;
+    }
+
+    archives.Reserve(static_cast<uint32_t>(summaries.size()));
+    for (size_t i = 0; i < summaries.size(); ++i)
+    {
+        const auto& summary = summaries[i];
+        GameDiagnosticsArchiveInfo info{};
+        info.path = relativePaths[static_cast<uint32_t>(i)];
+        info.isValid = summary.isValid;
+        info.version = summary.version;
+        info.fileCount = summary.fileCount;
+        info.segmentCount = summary.segmentCount;
+        info.dependencyCount = summary.dependencyCount;
+        info.size = summary.size;
+        info.compressedSize = summary.compressedSize;
+
+        info.resources.Reserve(static_cast<uint32_t>(summary.resources.size()));
+        for (const auto& resource : summary.resources)
+        {
+            info.resources.PushBack(
+                GameDiagnosticsArchiveResource{resource.hash, resource.size, resource.compressedSize});
+        }
+
+        archives.PushBack(info);
+    }
+
+    return true;
+}
+
 // Private Helpers
 
+bool CyberlibsCore::GameDiagnostics::compileGlobs(const Red::DynArray<Red::CString>& patterns,
+                                                  std::vector<GlobPattern>& globs)
+{
+    for (const auto& pattern : patterns)
+    {
+        GlobPattern glob;
+        if (!glob.Compile(pattern.c_str()))
+        {
+            return false;
+        }
+
+        globs.push_back(std::move(glob));
+    }
+
+    return true;
+}
+
 bool CyberlibsCore::GameDiagnostics::ensureDirectoryExists(const std::filesystem::path& path)
 {
     try
@@ -501,8 +1208,7 @@ std::filesystem::path CyberlibsCore::GameDiagnostics::getOutputPath(const Red::C
         std::filesystem::path basePath = std::filesystem::path(gamePath.c_str()) / "_DIAGNOSTICS";
         std::filesystem::path fullPath = basePath / cleanPath;
         std::filesystem::path normalizedPath = fullPath.lexically_normal();
-        std::string basePathStr = basePath.lexically_normal().string();
-        if (normalizedPath.string().substr(0, basePathStr.length()) != basePathStr)
+        if (!GameSandbox::IsWithin(basePath, normalizedPath) || !GameSandbox::Contains(normalizedPath))
         {
             return std::filesystem::path();
         }
@@ -515,27 +1221,20 @@ std::filesystem::path CyberlibsCore::GameDiagnostics::getOutputPath(const Red::C
     }
 }
 
-bool CyberlibsCore::GameDiagnostics::isPathSafe(const std::filesystem::path& path)
+uint64_t CyberlibsCore::GameDiagnostics::fileTimeToUnixSeconds(uint64_t fileTime)
 {
-    try
-    {
-        auto gamePath = std::filesystem::path(GetGamePath().c_str()).lexically_normal();
-        auto normalizedPath = path.lexically_normal();
-        auto gamePathStr = gamePath.string();
-        auto normalizedPathStr = normalizedPath.string();
+    // FILETIME counts 100 ns intervals since 1601-01-01.
+    constexpr uint64_t UNIX_EPOCH = 116444736000000000ull;
+    constexpr uint64_t TICKS_PER_SECOND = 10000000ull;
 
-        return normalizedPathStr.substr(0, gamePathStr.length()) == gamePathStr;
-    }
-    catch (const std::exception&)
-    {
-        return false;
-    }
+    return fileTime > UNIX_EPOCH ? (fileTime - UNIX_EPOCH) / TICKS_PER_SECOND : 0;
 }
 
 bool CyberlibsCore::GameDiagnostics::isTextFile(const std::filesystem::path& path)
 {
     std::string extension = path.extension().string();
-    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
 
     return std::any_of(
         std::begin(VALID_TEXT_EXTENSIONS),
@@ -544,60 +1243,13 @@ bool CyberlibsCore::GameDiagnostics::isTextFile(const std::filesystem::path& pat
     );
 }
 
-bool CyberlibsCore::GameDiagnostics::isValidUtf8(const std::string& str)
+Red::CString CyberlibsCore::GameDiagnostics::toScriptString(std::string_view line)
 {
-    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(str.c_str());
-    const size_t len = str.length();
-
-    for (size_t i = 0; i < len;)
-    {
-        if (bytes[i] <= 0x7F)
-        {
-            i++;
-            continue;
-        }
-
-        if (bytes[i] >= 0xC2 && bytes[i] <= 0xDF)
-        {
-            if (i + 1 >= len || (bytes[i + 1] & 0xC0) != 0x80)
-                return false;
-            i += 2;
-            continue;
-        }
-
-        if (bytes[i] >= 0xE0 && bytes[i] <= 0xEF)
-        {
-            if (i + 2 >= len || (bytes[i + 1] & 0xC0) != 0x80 || (bytes[i + 2] & 0xC0) != 0x80)
-                return false;
-
-            if (bytes[i] == 0xE0 && (bytes[i + 1] < 0xA0))
-                return false;
-            if (bytes[i] == 0xED && (bytes[i + 1] >= 0xA0))
-                return false;
-
-            i += 3;
-            continue;
-        }
-
-        if (bytes[i] >= 0xF0 && bytes[i] <= 0xF4)
-        {
-            if (i + 3 >= len || (bytes[i + 1] & 0xC0) != 0x80 || (bytes[i + 2] & 0xC0) != 0x80 ||
-                (bytes[i + 3] & 0xC0) != 0x80)
-                return false;
-
-            if (bytes[i] == 0xF0 && (bytes[i + 1] < 0x90))
-                return false;
-            if (bytes[i] == 0xF4 && (bytes[i + 1] >= 0x90))
-                return false;
-
-            i += 4;
-            continue;
-        }
-
-        return false;
-    }
+    std::string text(line);
+    // Keep the line readable rather than dropping it; only the undecodable bytes are lost.
+    TextEncoding::ReplaceInvalidUtf8(text);
 
-    return true;
+    return Red::CString(text.c_str());
 }
 
 std::string CyberlibsCore::GameDiagnostics::normalizePathString(std::string path)
@@ -611,74 +1263,56 @@ std::string CyberlibsCore::GameDiagnostics::normalizePathString(std::string path
     return path;
 }
 
-std::vector<CyberlibsCore::GameDiagnostics::PathValidation> CyberlibsCore::GameDiagnostics::readPaths(
-    const std::filesystem::path& path)
+bool CyberlibsCore::GameDiagnostics::openTextFile(const Red::CString& relativeFilePath, LineReader& reader)
 {
-    std::vector<PathValidation> paths;
-    std::ifstream file(path, std::ios::in | std::ios::binary);
-    if (!file.is_open())
-    {
-        return paths;
-    }
+    std::filesystem::path fullPath;
 
-    std::string line;
+    return resolveTextFile(relativeFilePath, fullPath) && reader.Open(fullPath);
+}
 
-    while (std::getline(file, line))
+bool CyberlibsCore::GameDiagnostics::resolveTextFile(const Red::CString& relativeFilePath,
+                                                     std::filesystem::path& fullPath)
+{
+    auto gamePath = GetGamePath();
+    if (gamePath.Length() == 0)
     {
-        if (!line.empty() && line.back() == '\r')
-        {
-            line.pop_back();
-        }
-
-        if (line.empty() || line[0] == '#')
-        {
-            continue;
-        }
+        return false;
+    }
 
-        size_t start = line.find_first_not_of(" \t");
-        if (start == std::string::npos)
-        {
-            continue;
-        }
+    std::string normalizedPath = normalizePathString(relativeFilePath);
+    fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
+    fullPath = fullPath.lexically_normal();
 
-        size_t end = line.find_last_not_of(" \t");
-        line = line.substr(start, end - start + 1);
+    return GameSandbox::Contains(fullPath) && std::filesystem::is_regular_file(fullPath) && isTextFile(fullPath);
+}
 
-        PathValidation validation;
+void CyberlibsCore::GameDiagnostics::appendMatches(const LineReader& reader, const std::vector<size_t>& lines,
+                                                   const Red::CString& path, int32_t contextLines,
+                                                   Red::DynArray<GameDiagnosticsSearchMatch>& matches)
+{
+    size_t context = static_cast<size_t>((std::max)(contextLines, 0));
+    for (size_t line : lines)
+    {
+        GameDiagnosticsSearchMatch match;
+        match.path = path;
+        match.line = static_cast<int32_t>(line + 1);
+        match.text = toScriptString(reader.Line(line));
 
-        if (line[0] == '!')
-        {
-            validation.shouldExist = false;
-            validation.path = line.substr(1);
-            start = validation.path.find_first_not_of(" \t");
-            if (start != std::string::npos)
-            {
-                end = validation.path.find_last_not_of(" \t");
-                validation.path = validation.path.substr(start, end - start + 1);
-            }
-        }
-        else
+        for (size_t i = line - (std::min)(context, line); i < line; ++i)
         {
-            validation.shouldExist = true;
+            match.before.PushBack(toScriptString(reader.Line(i)));
         }
 
-        size_t pipePos = line.find('|');
-        if (pipePos != std::string::npos)
+        for (size_t i = line + 1; i <= line + context && i < reader.LineCount(); ++i)
         {
-            validation.path = line.substr(0, pipePos);
-            end = validation.path.find_last_not_of(" \t");
-            validation.path = validation.path.substr(0, end + 1);
-        }
-        else
-        {
-            validation.path = line;
+            match.after.PushBack(toScriptString(reader.Line(i)));
         }
 
-        if (!validation.path.empty())
-        {
-            paths.push_back(validation);
-        }
+        matches.PushBack(match);
     }
+}
 
-    return paths;
+void CyberlibsCore::GameDiagnostics::startTreeCache(const Red::CString& gamePath)
+{
+    DirectoryTreeCache::Start(std::filesystem::path(gamePath.c_str()).lexically_normal());
 }
@@ -3,11 +3,31 @@
 #include <RED4ext/RED4ext.hpp>
 #include <RedLib.hpp>
 #include <sha256.h>
+#include "ArchiveIndex.hpp"
+#include "DiagnosticsScheduler.hpp"
+#include "DirectoryTreeCache.hpp"
+#include "DirectoryWalker.hpp"
+#include "FileReader.hpp"
+#include "FileStatBatch.hpp"
+#include "GameSandbox.hpp"
+#include "InstallState.hpp"
+#include "KnowledgeBaseIndex.hpp"
+#include "LineReader.hpp"
+#include "LineSearch.hpp"
+#include "LogFollower.hpp"
+#include "MappedFile.hpp"
+#include "OutputSink.hpp"
+#include "PathsParser.hpp"
+#include "PathsVerifier.hpp"
+#include "TextEncoding.hpp"
+#include "WorkStealingPool.hpp"
 
+#include <cctype>
 #include <string>
 #include <vector>
 #include <chrono>
 #include <filesystem>
+#include <functional>
 #include <fstream>
 #include <iomanip>
 #include <sstream>
@@ -19,53 +39,238 @@ struct GameDiagnosticsPathEntry
 public:
     Red::CString name;
     Red::CString type;
+    // Lowercase, with the leading dot; empty for directories and files without one.
+    Red::CString extension;
+    uint64_t size;
+    // Seconds since the Unix epoch, UTC.
+    uint64_t lastWriteTime;
+    uint32_t attributes;
+};
+
+struct GameDiagnosticsArchiveResource
+{
+public:
+    uint64_t hash;
+    uint64_t size;
+    uint64_t compressedSize;
+};
+
+struct GameDiagnosticsArchiveInfo
+{
+public:
+    // As passed in.
+    Red::CString path;
+    // False when the file is missing, leaves the game directory or is not a readable archive.
+    bool isValid;
+    uint32_t version;
+    uint32_t fileCount;
+    uint32_t segmentCount;
+    uint32_t dependencyCount;
+    // Uncompressed and compressed payload sizes, summed over all segments.
+    uint64_t size;
+    uint64_t compressedSize;
+    // Only filled with includeResources.
+    Red::DynArray<GameDiagnosticsArchiveResource> resources;
+};
+
+struct GameDiagnosticsFileStat
+{
+public:
+    // As passed in.
+    Red::CString path;
+    bool exists;
+    // "file", "dir", or empty when the path does not exist or leaves the game directory
+    Red::CString type;
+    uint64_t size;
+    // Seconds since the Unix epoch, UTC.
+    uint64_t lastWriteTime;
+    uint32_t attributes;
+};
+
+struct GameDiagnosticsFollowRead
+{
+public:
+    // Whole lines appended since the previous read.
+    Red::CString text;
+    // ok, truncated, rotated, missing or invalidHandle; after truncated and rotated the text starts at the
+    // beginning of the new file
+    Red::CString status;
+};
+
+struct GameDiagnosticsInstallChange
+{
+public:
+    Red::CString path;
+    // added, removed or modified
+    Red::CString change;
+    uint64_t sizeBefore;
+    uint64_t sizeAfter;
+};
+
+struct GameDiagnosticsPathsFailure
+{
+public:
+    Red::CString path;
+    int32_t line;
+    // missing, unexpected, sizeMismatch, hashMismatch, typeMismatch, unreadable, unsafePath, countMismatch,
+    // invalidPattern or invalidFile
+    Red::CString reason;
+};
+
+struct GameDiagnosticsSearchMatch
+{
+public:
+    // Relative to the searched directory for SearchFiles, '/' separated.
+    Red::CString path;
+    // 1-based
+    int32_t line;
+    Red::CString text;
+    Red::DynArray<Red::CString> before;
+    Red::DynArray<Red::CString> after;
+};
+
+struct GameDiagnosticsSearchOptions
+{
+public:
+    bool ignoreCase;
+    // ECMAScript regular expression, matched against the first 2048 bytes of one line at a time
+    bool regex;
+    // lines returned before and after each match
+    int32_t contextLines;
+    // per file, 0 returns every match
+    int32_t maxMatches;
+};
+
+struct GameDiagnosticsWalkEntry
+{
+public:
+    // Relative to the walked directory, '/' separated.
+    Red::CString path;
+    Red::CString name;
+    Red::CString type;
+    int32_t depth;
+};
+
+struct GameDiagnosticsWalkOptions
+{
+public:
+    // 0 walks the whole tree, 1 lists only direct children
+    int32_t maxDepth;
+    Red::DynArray<Red::CString> include;
+    // matching directories are skipped together with their contents
+    Red::DynArray<Red::CString> exclude;
+    bool filesOnly;
+    bool dirsOnly;
+    bool parallel;
+    // 0 picks half of the available hardware threads, only used with parallel
+    int32_t maxThreads;
 };
 
 struct GameDiagnostics : Red::IScriptable
 {
 public:
+    static void AddKnowledgeBasePath(const Red::CString& modName, const Red::CString& relativeFilePath);
+    // Captures the install state this session starts from, in the background. Called when the plugin loads.
+    static void BeginInstallSession();
+    static bool CloseFollow(uint64_t handle);
+    // Changes between the previous session and the start of this one, from memory.
+    static Red::DynArray<GameDiagnosticsInstallChange> DiffInstallState();
+    // Blocks until every WriteToOutput issued so far was written. False if some of it failed; it is retried with the
+    // next write.
+    static bool FlushOutput();
     static Red::CString GetCurrentTimeDate(Red::Optional<bool> pathFirendly);
-    static Red::CString GetFileHash(const Red::CString& relativeFilePath);
+    static Red::CString GetFileHash(const Red::CString& relativeFilePath, Red::Optional<bool> bypassCache);
     static Red::CString GetGamePath();
+    // -1 if the file cannot be read. Text files have no size limit here, unlike ReadTextFile.
+    static int32_t GetLineCount(const Red::CString& relativeFilePath);
     static Red::CString GetTimeDateStamp(const Red::CString& relativeFilePath, Red::Optional<bool> pathFriendly);
+    // Advances whenever the tree cache sees a change in one of the mod folders it watches.
+    static uint64_t GetTreeGeneration();
+    static bool HasChangedSince(const Red::CString& relativePath, uint64_t generation);
+    static bool HasInstallState();
+    static Red::DynArray<Red::CString> IdentifyPaths(const Red::DynArray<Red::CString>& relativeFilePaths);
     static bool IsFile(const Red::CString& relativeFilePath);
     static bool IsDirectory(const Red::CString& relativePath);
-    static Red::DynArray<GameDiagnosticsPathEntry> ListDirectory(const Red::CString& relativePath);
+    // sortBy is "name", "extension", "size" or "lastWriteTime"; anything else keeps enumeration order.
+    static Red::DynArray<GameDiagnosticsPathEntry> ListDirectory(const Red::CString& relativePath,
+                                                                 Red::Optional<Red::CString> sortBy,
+                                                                 Red::Optional<bool> descending);
+    // Starts following a log; 0 if the file cannot be opened. Without fromStart only later writes are returned.
+    static uint64_t OpenFollow(const Red::CString& relativeFilePath, Red::Optional<bool> fromStart);
+    // Reads only the header and index of each archive, in parallel. includeResources adds every resource hash with
+    // its sizes. Blocks the caller; GameDiagnosticsAsync::ReadArchiveIndexes is the same off the game thread.
+    static Red::DynArray<GameDiagnosticsArchiveInfo> ReadArchiveIndexes(
+        const Red::DynArray<Red::CString>& relativePaths, Red::Optional<bool> includeResources);
+    static Red::DynArray<Red::CString> ReadLines(const Red::CString& relativeFilePath, int32_t start, int32_t count);
+    static Red::DynArray<Red::CString> ReadTail(const Red::CString& relativeFilePath, int32_t count);
+    static GameDiagnosticsFollowRead ReadNew(uint64_t handle);
+    // UTF-16LE files and files with a UTF-8 byte order mark are returned as plain UTF-8.
     static Red::CString ReadTextFile(const Red::CString& relativeFilePath);
-    static bool VerifyPaths(const Red::CString& relativePathsFilePath);
+    // Sizes and write times only; GameDiagnosticsAsync::DiffInstallState hashes touched files off the game thread.
+    static bool SaveInstallState();
+    static Red::DynArray<GameDiagnosticsSearchMatch> SearchFile(const Red::CString& relativeFilePath,
+                                                                const Red::CString& needle,
+                                                                const GameDiagnosticsSearchOptions& options);
+    // Searches every text file under relativePath matching the include glob, in parallel.
+    static Red::DynArray<GameDiagnosticsSearchMatch> SearchFiles(const Red::CString& relativePath,
+                                                                 const Red::CString& include,
+                                                                 const Red::CString& needle,
+                                                                 const GameDiagnosticsSearchOptions& options);
+    static Red::DynArray<GameDiagnosticsFileStat> StatBatch(const Red::DynArray<Red::CString>& relativePaths);
+    // checkSizes compares the size column of lines that carry a sha256 one. Nothing is hashed on the game thread;
+    // GameDiagnosticsAsync::VerifyPaths checks the hashes.
+    static bool VerifyPaths(const Red::CString& relativePathsFilePath, Red::Optional<bool> checkSizes,
+                            Red::Optional<bool> stopOnFirstMismatch);
+    static Red::DynArray<GameDiagnosticsPathsFailure> VerifyPathsReport(const Red::CString& relativePathsFilePath,
+                                                                        Red::Optional<bool> checkSizes);
+    static Red::DynArray<GameDiagnosticsWalkEntry> Walk(const Red::CString& relativePath,
+                                                        const GameDiagnosticsWalkOptions& options);
+    // The content is queued and written in the background, in call order; true means it was queued. Appended files
+    // rotate to "<name>.1<ext>" at OutputSink::MAX_FILE_SIZE.
     static bool WriteToOutput(const Red::CString& relativeFilePath, const Red::CString& content,
                             Red::Optional<bool> append);
 
+    // Shared with GameDiagnosticsAsync, not exposed to scripts.
+    // Resolves and parses a .paths file inside the game directory; false if it is missing, unsafe or empty.
+    static bool LoadPaths(const Red::CString& relativePathsFilePath, MappedFile& pathsFile,
+                          std::vector<PathsParser::Record>& records, std::filesystem::path& gameRoot);
+    static void AppendPathsFailures(const std::vector<PathsParser::Record>& records,
+                                    const std::vector<PathsVerifier::Failure>& failures,
+                                    Red::DynArray<GameDiagnosticsPathsFailure>& report);
+    // False without a game path. Paths outside the game directory come back as invalid archives.
+    static bool LoadArchiveIndexes(const Red::DynArray<Red::CString>& relativePaths, bool includeResources,
+                                   Red::DynArray<GameDiagnosticsArchiveInfo>& archives, DiagnosticsJob* job = nullptr);
+
     RTTI_IMPL_TYPEINFO(CyberlibsCore::GameDiagnostics);
     RTTI_IMPL_ALLOCATOR();
 
 private:
-    struct PathValidation
-    {
-        std::string path;
-        bool shouldExist;
-    };
-
     static constexpr size_t MAX_INPUT_FILE_SIZE = 5 * 1024 * 1024;
-    static constexpr size_t MAX_OUTPUT_FILE_SIZE = 5 * 1024 * 1024;
     static constexpr const char* FILE_LOCKED = "File locked";
     static constexpr const char* FILE_READ_FAIL = "Failed to read file";
     static constexpr const char* INVALID_GAME_PATH = "Invalid game path";
+    static constexpr const char* INVALID_FILE_REASON = "invalidFile";
+    static constexpr const char* KNOWLEDGE_BASE_PATH =
+        "bin/x64/plugins/cyber_engine_tweaks/mods/Cyberlibs/knowledgeBase/modsResources";
     static constexpr const char* UNKNOWN_VALUE = "Unknown";
     static constexpr const char* VALID_TEXT_EXTENSIONS[] = {".txt", ".log", ".md"};
 
     static std::filesystem::path getOutputPath(const Red::CString& relativePath);
     static bool ensureDirectoryExists(const std::filesystem::path& path);
-    static bool isPathSafe(const std::filesystem::path& path);
+    static bool compileGlobs(const Red::DynArray<Red::CString>& patterns, std::vector<GlobPattern>& globs);
+    static uint64_t fileTimeToUnixSeconds(uint64_t fileTime);
     static bool isTextFile(const std::filesystem::path& path);
-    static bool isValidUtf8(const std::string& str);
+    static Red::CString toScriptString(std::string_view line);
     static std::string normalizePathString(std::string path);
+    static bool openTextFile(const Red::CString& relativeFilePath, LineReader& reader);
+    static bool resolveTextFile(const Red::CString& relativeFilePath, std::filesystem::path& fullPath);
+    static void appendMatches(const LineReader& reader, const std::vector<size_t>& lines, const Red::CString& path,
+                              int32_t contextLines, Red::DynArray<GameDiagnosticsSearchMatch>& matches);
+    static void startTreeCache(const Red::CString& gamePath);
     inline static std::string normalizePathString(const Red::CString& path)
     {
         return normalizePathString(std::string(path.c_str()));
     }
-
-    static std::vector<PathValidation> readPaths(const std::filesystem::path& path);
 };
 } // namespace CyberlibsCore
 
@@ -74,19 +279,140 @@ RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsPathEntry, {
 
     RTTI_PROPERTY(name);
     RTTI_PROPERTY(type);
+    RTTI_PROPERTY(extension);
+    RTTI_PROPERTY(size);
+    RTTI_PROPERTY(lastWriteTime);
+    RTTI_PROPERTY(attributes);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsArchiveResource, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsArchiveResource");
+
+    RTTI_PROPERTY(hash);
+    RTTI_PROPERTY(size);
+    RTTI_PROPERTY(compressedSize);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsArchiveInfo, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsArchiveInfo");
+
+    RTTI_PROPERTY(path);
+    RTTI_PROPERTY(isValid);
+    RTTI_PROPERTY(version);
+    RTTI_PROPERTY(fileCount);
+    RTTI_PROPERTY(segmentCount);
+    RTTI_PROPERTY(dependencyCount);
+    RTTI_PROPERTY(size);
+    RTTI_PROPERTY(compressedSize);
+    RTTI_PROPERTY(resources);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsFileStat, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsFileStat");
+
+    RTTI_PROPERTY(path);
+    RTTI_PROPERTY(exists);
+    RTTI_PROPERTY(type);
+    RTTI_PROPERTY(size);
+    RTTI_PROPERTY(lastWriteTime);
+    RTTI_PROPERTY(attributes);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsFollowRead, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsFollowRead");
+
+    RTTI_PROPERTY(text);
+    RTTI_PROPERTY(status);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsInstallChange, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsInstallChange");
+
+    RTTI_PROPERTY(path);
+    RTTI_PROPERTY(change);
+    RTTI_PROPERTY(sizeBefore);
+    RTTI_PROPERTY(sizeAfter);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsPathsFailure, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsPathsFailure");
+
+    RTTI_PROPERTY(path);
+    RTTI_PROPERTY(line);
+    RTTI_PROPERTY(reason);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsSearchMatch, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsSearchMatch");
+
+    RTTI_PROPERTY(path);
+    RTTI_PROPERTY(line);
+    RTTI_PROPERTY(text);
+    RTTI_PROPERTY(before);
+    RTTI_PROPERTY(after);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsSearchOptions, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsSearchOptions");
+
+    RTTI_PROPERTY(ignoreCase);
+    RTTI_PROPERTY(regex);
+    RTTI_PROPERTY(contextLines);
+    RTTI_PROPERTY(maxMatches);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsWalkEntry, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsWalkEntry");
+
+    RTTI_PROPERTY(path);
+    RTTI_PROPERTY(name);
+    RTTI_PROPERTY(type);
+    RTTI_PROPERTY(depth);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsWalkOptions, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsWalkOptions");
+
+    RTTI_PROPERTY(maxDepth);
+    RTTI_PROPERTY(include);
+    RTTI_PROPERTY(exclude);
+    RTTI_PROPERTY(filesOnly);
+    RTTI_PROPERTY(dirsOnly);
+    RTTI_PROPERTY(parallel);
+    RTTI_PROPERTY(maxThreads);
 });
 
 RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnostics, {
     RTTI_ALIAS("CyberlibsCore.GameDiagnostics");
 
+    RTTI_METHOD(AddKnowledgeBasePath);
+    RTTI_METHOD(CloseFollow);
+    RTTI_METHOD(DiffInstallState);
+    RTTI_METHOD(FlushOutput);
     RTTI_METHOD(GetCurrentTimeDate);
     RTTI_METHOD(GetFileHash);
     RTTI_METHOD(GetGamePath);
+    RTTI_METHOD(GetLineCount);
     RTTI_METHOD(GetTimeDateStamp);
+    RTTI_METHOD(GetTreeGeneration);
+    RTTI_METHOD(HasChangedSince);
+    RTTI_METHOD(HasInstallState);
+    RTTI_METHOD(IdentifyPaths);
     RTTI_METHOD(IsFile);
     RTTI_METHOD(IsDirectory);
     RTTI_METHOD(ListDirectory);
+    RTTI_METHOD(OpenFollow);
+    RTTI_METHOD(ReadArchiveIndexes);
+    RTTI_METHOD(ReadLines);
+    RTTI_METHOD(ReadTail);
+    RTTI_METHOD(ReadNew);
     RTTI_METHOD(ReadTextFile);
+    RTTI_METHOD(SaveInstallState);
+    RTTI_METHOD(SearchFile);
+    RTTI_METHOD(SearchFiles);
+    RTTI_METHOD(StatBatch);
     RTTI_METHOD(VerifyPaths);
+    RTTI_METHOD(VerifyPathsReport);
+    RTTI_METHOD(Walk);
     RTTI_METHOD(WriteToOutput);
 });
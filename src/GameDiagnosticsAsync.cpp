@@ -1,13 +1,166 @@
 #include "GameDiagnosticsAsync.hpp"
+#include "GameModules.hpp"
 
-void CyberlibsCore::GameDiagnosticsAsync::GetFileHash(const Red::CString& relativeFilePath,
-                                                      const CyberlibsCore::GameDiagnosticsHashPromise& promise)
+bool CyberlibsCore::GameDiagnosticsAsync::Cancel(uint64_t handle)
 {
-    Red::JobQueue job_queue;
+    return DiagnosticsJobs::Cancel(handle);
+}
+
+uint64_t CyberlibsCore::GameDiagnosticsAsync::CreateBundle(const GameDiagnosticsBundleOptions& options,
+                                                           const GameDiagnosticsBundlePromise& promise)
+{
+    auto job = createJob(promise);
+
+    DiagnosticsScheduler::Submit(
+        toSchedulerPriority(promise.priority, DiagnosticsScheduler::Priority::Background),
+        [options, promise, job]() -> void
+        {
+            DiagnosticsJobs::Scope jobScope(job);
+
+            std::string bundlePath;
+            std::string error = createBundle(options, *job, bundlePath);
+            if (error.empty())
+            {
+                job->Complete();
+                promise.Success(Red::CString(bundlePath.c_str()));
+            }
+            else
+            {
+                promise.Error(Red::CString(error.c_str()));
+            }
+        },
+        dropJob(promise, job));
+
+    return job->GetHandle();
+}
+
+uint64_t CyberlibsCore::GameDiagnosticsAsync::DiffInstallState(const GameDiagnosticsInstallDiffPromise& promise,
+                                                               Red::Optional<bool> hashFiles)
+{
+    auto job = createJob(promise);
+
+    DiagnosticsScheduler::Submit(
+        toSchedulerPriority(promise.priority, DiagnosticsScheduler::Priority::Background),
+        [promise, hashFiles = static_cast<bool>(hashFiles), job]() -> void
+        {
+            DiagnosticsJobs::Scope jobScope(job);
+
+            Red::DynArray<GameDiagnosticsInstallChange> changes;
+            std::string error = diffInstallState(hashFiles, *job, changes);
+            if (error.empty())
+            {
+                job->Complete();
+                promise.Success(changes);
+            }
+            else
+            {
+                promise.Error(Red::CString(error.c_str()));
+            }
+        },
+        dropJob(promise, job));
+
+    return job->GetHandle();
+}
 
-    job_queue.Dispatch(
-        [relativeFilePath, promise]() -> void
+CyberlibsCore::GameDiagnosticsSchedulerStats CyberlibsCore::GameDiagnosticsAsync::GetSchedulerStats()
+{
+    auto stats = DiagnosticsScheduler::GetStats();
+    auto& interactive = stats.classes[static_cast<size_t>(DiagnosticsScheduler::Priority::Interactive)];
+    auto& background = stats.classes[static_cast<size_t>(DiagnosticsScheduler::Priority::Background)];
+    auto& idle = stats.classes[static_cast<size_t>(DiagnosticsScheduler::Priority::Idle)];
+
+    GameDiagnosticsSchedulerStats schedulerStats;
+    schedulerStats.interactiveQueued = static_cast<int32_t>(interactive.queued);
+    schedulerStats.interactiveRunning = static_cast<int32_t>(interactive.running);
+    schedulerStats.interactiveCompleted = interactive.completed;
+    schedulerStats.backgroundQueued = static_cast<int32_t>(background.queued);
+    schedulerStats.backgroundRunning = static_cast<int32_t>(background.running);
+    schedulerStats.backgroundCompleted = background.completed;
+    schedulerStats.idleQueued = static_cast<int32_t>(idle.queued);
+    schedulerStats.idleRunning = static_cast<int32_t>(idle.running);
+    schedulerStats.idleCompleted = idle.completed;
+    schedulerStats.concurrency = static_cast<int32_t>(stats.concurrency);
+
+    return schedulerStats;
+}
+
+CyberlibsCore::GameDiagnosticsJobProgress CyberlibsCore::GameDiagnosticsAsync::GetProgress(uint64_t handle)
+{
+    auto job = DiagnosticsJobs::Find(handle);
+    if (!job)
+    {
+        return GameDiagnosticsJobProgress{};
+    }
+
+    auto progress = toJobProgress(job->GetProgress());
+    progress.handle = handle;
+
+    return progress;
+}
+
+uint64_t CyberlibsCore::GameDiagnosticsAsync::GetFileHash(const Red::CString& relativeFilePath,
+                                                          const CyberlibsCore::GameDiagnosticsHashPromise& promise,
+                                                          Red::Optional<bool> bypassCache)
+{
+    // Repeated requests for a file that is already being hashed join the running job instead of reading it again.
+    // A request that bypasses the cache only joins another one that does, since it asked for a fresh read from disk.
+    bool bypass = bypassCache;
+    std::string mode = bypass ? "sha256+uncached:" : "sha256:";
+    auto attachment = hashJobs_.Attach(mode + inFlightKey(relativeFilePath), promise);
+    if (!attachment.isLeader)
+    {
+        return attachment.handle;
+    }
+
+    auto group = attachment.group;
+
+    DiagnosticsScheduler::Submit(
+        toSchedulerPriority(promise.priority, DiagnosticsScheduler::Priority::Interactive),
+        [relativeFilePath, bypass, group]() -> void
         {
+            DiagnosticsJobs::Scope jobScope(group->job);
+
+            std::string hash;
+            std::string error = hashFile(relativeFilePath, bypass, *group->job, hash);
+            if (error.empty())
+            {
+                group->job->Complete();
+            }
+
+            for (const auto& subscriber : hashJobs_.Complete(group))
+            {
+                if (!DiagnosticsJobs::IsSubscribed(subscriber.handle))
+                {
+                    continue;
+                }
+
+                if (error.empty())
+                {
+                    subscriber.promise.Success(Red::CString(hash.c_str()));
+                }
+                else
+                {
+                    subscriber.promise.Error(Red::CString(error.c_str()));
+                }
+            }
+        },
+        dropGroup(hashJobs_, group));
+
+    return attachment.handle;
+}
+
+uint64_t CyberlibsCore::GameDiagnosticsAsync::HashDirectory(const Red::CString& relativePath,
+                                                            const GameDiagnosticsHashDirectoryOptions& options,
+                                                            const GameDiagnosticsHashDirectoryPromise& promise)
+{
+    auto job = createJob(promise);
+
+    DiagnosticsScheduler::Submit(
+        toSchedulerPriority(promise.priority, DiagnosticsScheduler::Priority::Background),
+        [relativePath, options, promise, job]() -> void
+        {
+            DiagnosticsJobs::Scope jobScope(job);
+
             try
             {
                 auto gamePath = GameDiagnostics::GetGamePath();
@@ -18,56 +171,129 @@ void CyberlibsCore::GameDiagnosticsAsync::GetFileHash(const Red::CString& relati
                     return;
                 }
 
-                std::string normalizedPath = normalizePathString(relativeFilePath);
-                std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
-                fullPath = fullPath.lexically_normal();
-                if (!isPathSafe(fullPath) || !std::filesystem::exists(fullPath) ||
-                    !std::filesystem::is_regular_file(fullPath))
+                const std::filesystem::path gameRoot = std::filesystem::path(gamePath.c_str()).lexically_normal();
+                std::string normalizedPath = normalizePathString(relativePath);
+                std::filesystem::path fullPath = (gameRoot / normalizedPath).lexically_normal();
+                if (!GameSandbox::Contains(fullPath) || !std::filesystem::exists(fullPath) ||
+                    !std::filesystem::is_directory(fullPath))
                 {
                     promise.Error(UNKNOWN_VALUE);
 
                     return;
                 }
 
-                HANDLE hFile =
-                    CreateFileW(fullPath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
-                                NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+                std::vector<ManifestEntry> entries;
+                auto iteratorOptions = std::filesystem::directory_options::skip_permission_denied;
+                for (const auto& entry : std::filesystem::recursive_directory_iterator(fullPath, iteratorOptions))
+                {
+                    if (!entry.is_regular_file())
+                    {
+                        continue;
+                    }
+
+                    ManifestEntry manifestEntry;
+                    manifestEntry.path = entry.path().lexically_relative(gameRoot).generic_string();
+                    manifestEntry.size = entry.file_size();
+                    manifestEntry.lastWriteTime = formatFileTime(entry.last_write_time());
+                    entries.push_back(std::move(manifestEntry));
+                }
 
-                if (hFile == INVALID_HANDLE_VALUE)
+                std::sort(entries.begin(), entries.end(),
+                          [](const ManifestEntry& a, const ManifestEntry& b) { return a.path < b.path; });
+
+                uint64_t totalBytes = 0;
+                for (const auto& entry : entries)
                 {
-                    promise.Error(FILE_LOCKED);
+                    totalBytes += entry.size;
+                }
+
+                job->SetTotals(totalBytes, static_cast<uint32_t>(entries.size()));
+
+                FileReader::Options readOptions;
+                readOptions.bypassCache = options.bypassCache;
+                readOptions.job = job.get();
+
+                WorkStealingPool::Run(entries.size(), DiagnosticsScheduler::ThreadBudget(options.maxThreads),
+                                      [&entries, &gameRoot, &readOptions, &job](size_t index)
+                                      {
+                                          if (job->IsCancelled())
+                                          {
+                                              return;
+                                          }
+
+                                          auto& entry = entries[index];
+                                          if (FileReader::HashFile(gameRoot / entry.path, readOptions, entry.hash) !=
+                                              FileReader::Status::Ok)
+                                          {
+                                              entry.hash.clear();
+                                          }
+
+                                          job->AddFiles(1);
+                                      });
+
+                if (job->IsCancelled())
+                {
+                    promise.Error(JOB_CANCELLED);
 
                     return;
                 }
 
-                std::unique_ptr<void, decltype(&CloseHandle)> fileGuard(hFile, CloseHandle);
-                struct sha256_buff sha_buff;
-                sha256_init(&sha_buff);
-                uint8_t buffer[8192];
-                DWORD bytesRead = 0;
-
-                while (true)
+                // Same "path | hash" lines the knowledge base .paths files use, so the manifest can be verified
+                // as-is. Files that could not be read keep only their path and are checked for existence; they are
+                // also handed back to the caller so a partial manifest is never mistaken for a complete one.
+                std::string manifest;
+                Red::DynArray<Red::CString> failedFiles;
+                for (const auto& entry : entries)
                 {
-                    if (!ReadFile(hFile, buffer, sizeof(buffer), &bytesRead, NULL))
+                    manifest += entry.path;
+                    if (entry.hash.empty())
+                    {
+                        failedFiles.PushBack(Red::CString(entry.path.c_str()));
+                    }
+                    else
                     {
-                        promise.Error(FILE_READ_FAIL);
+                        manifest += " | " + entry.hash;
 
-                        return;
+                        if (options.includeMetadata)
+                        {
+                            manifest += " | " + std::to_string(entry.size) + " | " + entry.lastWriteTime;
+                        }
                     }
 
-                    if (bytesRead == 0)
+                    manifest += "\n";
+                }
+
+                std::string outputPath = normalizePathString(options.outputFilePath);
+                if (outputPath.empty())
+                {
+                    std::string directoryName = fullPath.filename().string();
+                    if (directoryName.empty() || fullPath == gameRoot)
                     {
-                        break;
+                        directoryName = "Cyberpunk 2077";
                     }
 
-                    sha256_update(&sha_buff, buffer, bytesRead);
+                    outputPath = "_PATHS/" + directoryName + "-" +
+                                 GameDiagnostics::GetCurrentTimeDate(true).c_str() + ".paths";
+                }
+                else if (outputPath.find('/') == std::string::npos)
+                {
+                    // WriteToOutput only writes into subfolders of _DIAGNOSTICS; a bare name goes where the default
+                    // would.
+                    outputPath = "_PATHS/" + outputPath;
                 }
 
-                sha256_finalize(&sha_buff);
-                char hashStr[65] = {0};
-                sha256_read_hex(&sha_buff, hashStr);
+                // WriteToOutput only queues the write; the path handed to Success has to exist by then.
+                if (!GameDiagnostics::WriteToOutput(Red::CString(outputPath.c_str()), Red::CString(manifest.c_str()),
+                                                    false) ||
+                    !GameDiagnostics::FlushOutput())
+                {
+                    promise.Error(FILE_WRITE_FAIL);
 
-                promise.Success(Red::CString(hashStr));
+                    return;
+                }
+
+                job->Complete();
+                promise.Success(Red::CString(outputPath.c_str()), failedFiles);
             }
             catch (const std::exception& e)
             {
@@ -75,195 +301,674 @@ void CyberlibsCore::GameDiagnosticsAsync::GetFileHash(const Red::CString& relati
                 errorMsg += e.what();
                 promise.Error(Red::CString(errorMsg.c_str()));
             }
-        });
+        },
+        dropJob(promise, job));
+
+    return job->GetHandle();
 }
 
-void CyberlibsCore::GameDiagnosticsAsync::VerifyPaths(const Red::CString& relativePathsFilePath,
-                                                      const GameDiagnosticsVerifyPathsPromise& promise)
+uint64_t CyberlibsCore::GameDiagnosticsAsync::HashFileChunks(const Red::CString& relativeFilePath,
+                                                             const GameDiagnosticsChunkHashOptions& options,
+                                                             const GameDiagnosticsChunkHashPromise& promise)
 {
-    Red::JobQueue job_queue;
+    auto job = createJob(promise);
 
-    job_queue.Dispatch(
-        [relativePathsFilePath, promise]() -> void
+    DiagnosticsScheduler::Submit(
+        toSchedulerPriority(promise.priority, DiagnosticsScheduler::Priority::Background),
+        [relativeFilePath, options, promise, job]() -> void
         {
+            DiagnosticsJobs::Scope jobScope(job);
+
             try
             {
-                auto gamePath = GameDiagnostics::GetGamePath();
-                if (gamePath.Length() == 0)
+                std::filesystem::path fullPath = resolveFilePath(relativeFilePath);
+                if (fullPath.empty())
                 {
-                    promise.Resolve(false);
+                    promise.Error(UNKNOWN_VALUE);
 
                     return;
                 }
 
-                std::string normalizedInputPath = relativePathsFilePath.c_str();
-                std::replace(normalizedInputPath.begin(), normalizedInputPath.end(), '\\', '/');
-                std::filesystem::path inputPath = std::filesystem::path(gamePath.c_str()) / normalizedInputPath;
-                inputPath = inputPath.lexically_normal();
+                // Checked before hashing, so a bad output path does not cost a full read of the file.
+                std::string outputPath = normalizePathString(options.outputFilePath);
+                if (outputPath.empty())
+                {
+                    outputPath = "_CHUNKS/" + fullPath.filename().string() + "-" +
+                                 GameDiagnostics::GetCurrentTimeDate(true).c_str() + ".chunks";
+                }
+                else if (outputPath.find('/') == std::string::npos)
+                {
+                    // WriteToOutput only writes into subfolders of _DIAGNOSTICS; a bare name goes where the default
+                    // would.
+                    outputPath = "_CHUNKS/" + outputPath;
+                }
 
-                if (!isPathSafe(inputPath) || !std::filesystem::exists(inputPath) ||
-                    !std::filesystem::is_regular_file(inputPath))
+                const std::filesystem::path gameRoot =
+                    std::filesystem::path(GameDiagnostics::GetGamePath().c_str()).lexically_normal();
+                if (resolveOutputPath(gameRoot, outputPath).empty())
                 {
-                    promise.Resolve(false);
+                    promise.Error(FILE_WRITE_FAIL);
 
                     return;
                 }
 
-                auto fileSize = std::filesystem::file_size(inputPath);
-                if (fileSize > MAX_INPUT_FILE_SIZE)
+                // Chunk boundaries stay sector-aligned so chunks can also be read with the cache bypassed.
+                uint64_t chunkSize = options.chunkSize > 0 ? static_cast<uint64_t>(options.chunkSize)
+                                                           : ChunkedHash::DEFAULT_CHUNK_SIZE;
+                chunkSize = (chunkSize + FileReader::SECTOR_ALIGNMENT - 1) & ~(FileReader::SECTOR_ALIGNMENT - 1);
+
+                FileReader::Options readOptions;
+                readOptions.bypassCache = options.bypassCache;
+                readOptions.job = job.get();
+
+                ChunkedHash::Manifest manifest;
+                switch (ChunkedHash::Build(fullPath, chunkSize, DiagnosticsScheduler::ThreadBudget(options.maxThreads),
+                                           readOptions, manifest))
                 {
-                    promise.Resolve(false);
+                case FileReader::Status::Ok:
+                    break;
+                case FileReader::Status::OpenFailed:
+                    promise.Error(FILE_LOCKED);
+                    return;
+                case FileReader::Status::Cancelled:
+                    promise.Error(JOB_CANCELLED);
+                    return;
+                default:
+                    promise.Error(FILE_READ_FAIL);
                     return;
                 }
 
-                auto extension = inputPath.extension().string();
-                std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
-                if (extension != ".paths")
+                std::string content = ChunkedHash::Serialize(manifest);
+                if (!GameDiagnostics::WriteToOutput(Red::CString(outputPath.c_str()), Red::CString(content.c_str()),
+                                                    false) ||
+                    !GameDiagnostics::FlushOutput())
                 {
-                    promise.Resolve(false);
+                    promise.Error(FILE_WRITE_FAIL);
+
                     return;
                 }
 
-                std::ifstream file(inputPath, std::ios::binary);
-                if (!file.is_open())
+                job->Complete();
+                promise.Success(Red::CString(ChunkedHash::ToHex(manifest.root).c_str()),
+                                Red::CString(outputPath.c_str()));
+            }
+            catch (const std::exception& e)
+            {
+                std::string errorMsg = "Exception: ";
+                errorMsg += e.what();
+                promise.Error(Red::CString(errorMsg.c_str()));
+            }
+        },
+        dropJob(promise, job));
+
+    return job->GetHandle();
+}
+
+uint64_t CyberlibsCore::GameDiagnosticsAsync::ReadArchiveIndexes(const Red::DynArray<Red::CString>& relativePaths,
+                                                                 const GameDiagnosticsArchiveIndexesPromise& promise,
+                                                                 Red::Optional<bool> includeResources)
+{
+    auto job = createJob(promise);
+
+    DiagnosticsScheduler::Submit(
+        toSchedulerPriority(promise.priority, DiagnosticsScheduler::Priority::Background),
+        [relativePaths, promise, includeResources = static_cast<bool>(includeResources), job]() -> void
+        {
+            DiagnosticsJobs::Scope jobScope(job);
+
+            Red::DynArray<GameDiagnosticsArchiveInfo> archives;
+            std::string error = readArchiveIndexes(relativePaths, includeResources, *job, archives);
+            // Scripts keep a single read going and start the next one right after cancelling, so a late result
+            // would land on it.
+            if (!DiagnosticsJobs::IsSubscribed(job->GetHandle()))
+            {
+                return;
+            }
+
+            if (error.empty())
+            {
+                job->Complete();
+                promise.Success(archives);
+            }
+            else
+            {
+                promise.Error(Red::CString(error.c_str()));
+            }
+        },
+        dropJob(promise, job));
+
+    return job->GetHandle();
+}
+
+uint64_t CyberlibsCore::GameDiagnosticsAsync::VerifyPaths(const Red::CString& relativePathsFilePath,
+                                                          const GameDiagnosticsVerifyPathsPromise& promise,
+                                                          Red::Optional<bool> verifyHashes,
+                                                          Red::Optional<bool> stopOnFirstMismatch)
+{
+    bool hashes = verifyHashes;
+    bool stop = stopOnFirstMismatch;
+    std::string mode = std::string(hashes ? "verify+sha256" : "verify") + (stop ? "+stop:" : ":");
+    auto attachment = verifyPathsJobs_.Attach(mode + inFlightKey(relativePathsFilePath), promise);
+    if (!attachment.isLeader)
+    {
+        return attachment.handle;
+    }
+
+    auto group = attachment.group;
+
+    DiagnosticsScheduler::Submit(
+        toSchedulerPriority(promise.priority, DiagnosticsScheduler::Priority::Interactive),
+        [relativePathsFilePath, hashes, stop, group]() -> void
+        {
+            DiagnosticsJobs::Scope jobScope(group->job);
+
+            bool isValid = verifyPaths(relativePathsFilePath, hashes, stop, *group->job);
+            bool isCancelled = group->job->IsCancelled();
+            if (isValid)
+            {
+                group->job->Complete();
+            }
+
+            for (const auto& subscriber : verifyPathsJobs_.Complete(group))
+            {
+                if (!DiagnosticsJobs::IsSubscribed(subscriber.handle))
                 {
-                    promise.Resolve(false);
-                    return;
+                    continue;
                 }
 
-                std::string fileContent((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
-                file.close();
+                if (isCancelled)
+                {
+                    subscriber.promise.Error(JOB_CANCELLED);
+                }
+                else
+                {
+                    subscriber.promise.Resolve(isValid);
+                }
+            }
+        },
+        dropGroup(verifyPathsJobs_, group));
+
+    return attachment.handle;
+}
 
-                if (!isValidUtf8(fileContent))
+uint64_t CyberlibsCore::GameDiagnosticsAsync::VerifyPathsReport(const Red::CString& relativePathsFilePath,
+                                                                const GameDiagnosticsVerifyPathsReportPromise& promise,
+                                                                Red::Optional<bool> verifyHashes)
+{
+    bool hashes = verifyHashes;
+    std::string mode = hashes ? "report+sha256:" : "report:";
+    auto attachment = verifyPathsReportJobs_.Attach(mode + inFlightKey(relativePathsFilePath), promise);
+    if (!attachment.isLeader)
+    {
+        return attachment.handle;
+    }
+
+    auto group = attachment.group;
+
+    DiagnosticsScheduler::Submit(
+        toSchedulerPriority(promise.priority, DiagnosticsScheduler::Priority::Interactive),
+        [relativePathsFilePath, hashes, group]() -> void
+        {
+            DiagnosticsJobs::Scope jobScope(group->job);
+
+            Red::DynArray<GameDiagnosticsPathsFailure> report;
+            std::string error = verifyPathsReport(relativePathsFilePath, hashes, *group->job, report);
+            if (error.empty())
+            {
+                group->job->Complete();
+            }
+
+            for (const auto& subscriber : verifyPathsReportJobs_.Complete(group))
+            {
+                if (!DiagnosticsJobs::IsSubscribed(subscriber.handle))
                 {
-                    promise.Resolve(false);
+                    continue;
+                }
+
+                if (error.empty())
+                {
+                    subscriber.promise.Resolve(report);
+                }
+                else
+                {
+                    subscriber.promise.Error(Red::CString(error.c_str()));
+                }
+            }
+        },
+        dropGroup(verifyPathsReportJobs_, group));
+
+    return attachment.handle;
+}
+
+uint64_t CyberlibsCore::GameDiagnosticsAsync::VerifyFileChunks(const Red::CString& relativeFilePath,
+                                                               const Red::CString& relativeManifestPath,
+                                                               const GameDiagnosticsChunkVerifyOptions& options,
+                                                               const GameDiagnosticsChunkVerifyPromise& promise)
+{
+    auto job = createJob(promise);
+
+    DiagnosticsScheduler::Submit(
+        toSchedulerPriority(promise.priority, DiagnosticsScheduler::Priority::Background),
+        [relativeFilePath, relativeManifestPath, options, promise, job]() -> void
+        {
+            DiagnosticsJobs::Scope jobScope(job);
+
+            try
+            {
+                std::filesystem::path fullPath = resolveFilePath(relativeFilePath);
+                std::filesystem::path manifestPath = resolveFilePath(relativeManifestPath);
+                if (fullPath.empty() || manifestPath.empty() ||
+                    std::filesystem::file_size(manifestPath) > MAX_INPUT_FILE_SIZE)
+                {
+                    promise.Error(UNKNOWN_VALUE);
+
                     return;
                 }
 
-                auto validations = readLines(inputPath);
-                if (validations.empty())
+                std::ifstream file(manifestPath, std::ios::binary);
+                if (!file.is_open())
                 {
-                    promise.Resolve(false);
+                    promise.Error(FILE_READ_FAIL);
 
                     return;
                 }
 
-                const std::filesystem::path gameRoot = std::filesystem::path(gamePath.c_str()).lexically_normal();
+                std::string manifestContent((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+                file.close();
 
-                for (const auto& validation : validations)
+                ChunkedHash::Manifest manifest;
+                if (!ChunkedHash::Parse(manifestContent, manifest))
                 {
-                    std::string cleanPath = validation.path;
-                    std::replace(cleanPath.begin(), cleanPath.end(), '\\', '/');
-                    if (cleanPath.empty() || cleanPath[0] == '#')
-                    {
-                        continue;
-                    }
+                    promise.Error(INVALID_MANIFEST);
 
-                    while (!cleanPath.empty() && (cleanPath[0] == '/' || cleanPath[0] == '\\'))
-                    {
-                        cleanPath = cleanPath.substr(1);
-                    }
+                    return;
+                }
 
-                    std::filesystem::path pathToCheck = gameRoot / cleanPath;
-                    pathToCheck = pathToCheck.lexically_normal();
-                    if (!isPathSafe(pathToCheck))
-                    {
-                        promise.Resolve(false);
+                std::vector<ChunkedHash::ByteRange> changedRanges;
+                for (const auto& range : options.changedRanges)
+                {
+                    changedRanges.push_back({range.offset, range.size});
+                }
 
-                        return;
-                    }
+                FileReader::Options readOptions;
+                readOptions.bypassCache = options.bypassCache;
+                readOptions.job = job.get();
 
-                    bool exists = std::filesystem::exists(pathToCheck);
-                    if (validation.shouldExist != exists)
-                    {
-                        promise.Resolve(false);
+                ChunkedHash::VerifyResult result;
+                switch (ChunkedHash::Verify(fullPath, manifest, changedRanges,
+                                            DiagnosticsScheduler::ThreadBudget(options.maxThreads), readOptions,
+                                            result))
+                {
+                case FileReader::Status::Ok:
+                    break;
+                case FileReader::Status::OpenFailed:
+                    promise.Error(FILE_LOCKED);
+                    return;
+                case FileReader::Status::Cancelled:
+                    promise.Error(JOB_CANCELLED);
+                    return;
+                default:
+                    promise.Error(FILE_READ_FAIL);
+                    return;
+                }
 
-                        return;
-                    }
+                Red::DynArray<GameDiagnosticsByteRange> mismatches;
+                for (const auto& range : result.mismatches)
+                {
+                    GameDiagnosticsByteRange mismatch;
+                    mismatch.offset = range.offset;
+                    mismatch.size = range.size;
+                    mismatches.PushBack(mismatch);
                 }
 
-                promise.Resolve(true);
+                job->Complete();
+                promise.Resolve(result.mismatches.empty(), mismatches);
             }
-            catch (const std::exception&)
+            catch (const std::exception& e)
             {
-                promise.Resolve(false);
+                std::string errorMsg = "Exception: ";
+                errorMsg += e.what();
+                promise.Error(Red::CString(errorMsg.c_str()));
             }
-        });
+        },
+        dropJob(promise, job));
+
+    return job->GetHandle();
 }
 
 // Private Helpers
 
-bool CyberlibsCore::GameDiagnosticsAsync::isPathSafe(const std::filesystem::path& path)
+CyberlibsCore::DiagnosticsScheduler::Priority CyberlibsCore::GameDiagnosticsAsync::toSchedulerPriority(
+    GameDiagnosticsPriority priority, DiagnosticsScheduler::Priority fallback)
+{
+    switch (priority)
+    {
+    case GameDiagnosticsPriority::Interactive:
+        return DiagnosticsScheduler::Priority::Interactive;
+    case GameDiagnosticsPriority::Background:
+        return DiagnosticsScheduler::Priority::Background;
+    case GameDiagnosticsPriority::Idle:
+        return DiagnosticsScheduler::Priority::Idle;
+    default:
+        return fallback;
+    }
+}
+
+CyberlibsCore::GameDiagnosticsJobProgress CyberlibsCore::GameDiagnosticsAsync::toJobProgress(
+    const DiagnosticsJob::Progress& progress)
+{
+    GameDiagnosticsJobProgress jobProgress;
+    jobProgress.handle = progress.handle;
+    jobProgress.bytesDone = progress.bytesDone;
+    jobProgress.bytesTotal = progress.bytesTotal;
+    jobProgress.filesDone = static_cast<int32_t>(progress.filesDone);
+    jobProgress.filesTotal = static_cast<int32_t>(progress.filesTotal);
+
+    return jobProgress;
+}
+
+std::string CyberlibsCore::GameDiagnosticsAsync::hashFile(const Red::CString& relativeFilePath, bool bypassCache,
+                                                         DiagnosticsJob& job, std::string& hash)
 {
     try
     {
-        auto gamePath = std::filesystem::path(GameDiagnostics::GetGamePath().c_str()).lexically_normal();
-        auto normalizedPath = path.lexically_normal();
-        auto gamePathStr = gamePath.string();
-        auto normalizedPathStr = normalizedPath.string();
+        auto gamePath = GameDiagnostics::GetGamePath();
+        if (gamePath.Length() == 0)
+        {
+            return INVALID_GAME_PATH;
+        }
+
+        std::string normalizedPath = normalizePathString(relativeFilePath);
+        std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
+        fullPath = fullPath.lexically_normal();
+        if (!GameSandbox::Contains(fullPath) || !std::filesystem::exists(fullPath) ||
+            !std::filesystem::is_regular_file(fullPath))
+        {
+            return UNKNOWN_VALUE;
+        }
+
+        job.SetTotals(std::filesystem::file_size(fullPath), 1);
+
+        FileReader::Options readOptions;
+        readOptions.bypassCache = bypassCache;
+        readOptions.job = &job;
 
-        return normalizedPathStr.substr(0, gamePathStr.length()) == gamePathStr;
+        switch (FileReader::HashFile(fullPath, readOptions, hash))
+        {
+        case FileReader::Status::Ok:
+            return std::string();
+        case FileReader::Status::OpenFailed:
+            return FILE_LOCKED;
+        case FileReader::Status::Cancelled:
+            return JOB_CANCELLED;
+        default:
+            return FILE_READ_FAIL;
+        }
     }
-    catch (const std::exception&)
+    catch (const std::exception& e)
     {
-        return false;
+        std::string errorMsg = "Exception: ";
+        errorMsg += e.what();
+
+        return errorMsg;
     }
 }
 
-bool CyberlibsCore::GameDiagnosticsAsync::isValidUtf8(const std::string& str)
+std::string CyberlibsCore::GameDiagnosticsAsync::createBundle(const GameDiagnosticsBundleOptions& options,
+                                                             DiagnosticsJob& job, std::string& bundlePath)
 {
-    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(str.c_str());
-    const size_t len = str.length();
-
-    for (size_t i = 0; i < len;)
+    try
     {
-        if (bytes[i] <= 0x7F)
+        auto gamePath = GameDiagnostics::GetGamePath();
+        if (gamePath.Length() == 0)
+        {
+            return INVALID_GAME_PATH;
+        }
+
+        const std::filesystem::path gameRoot = std::filesystem::path(gamePath.c_str()).lexically_normal();
+
+        bundlePath = normalizePathString(options.outputFilePath);
+        if (bundlePath.empty())
         {
-            i++;
-            continue;
+            bundlePath = std::string("_BUNDLES/diagnostics-") + GameDiagnostics::GetCurrentTimeDate(true).c_str() +
+                         ".zip";
         }
 
-        if (bytes[i] >= 0xC2 && bytes[i] <= 0xDF)
+        std::filesystem::path outputPath = resolveOutputPath(gameRoot, bundlePath);
+        std::error_code ec;
+        if (outputPath.empty() || (!std::filesystem::create_directories(outputPath.parent_path(), ec) && ec))
         {
-            if (i + 1 >= len || (bytes[i + 1] & 0xC0) != 0x80)
-                return false;
-            i += 2;
-            continue;
+            return FILE_WRITE_FAIL;
         }
 
-        if (bytes[i] >= 0xE0 && bytes[i] <= 0xEF)
+        // Files go into the archive straight from disk; only the generated text entries are built in memory. A file
+        // asked for twice (or also picked as a log) is added once.
+        std::vector<std::pair<std::string, std::filesystem::path>> files;
+        std::unordered_set<std::wstring> addedFiles;
+        auto addFile = [&files, &addedFiles, &gameRoot](std::string name, const std::string& relativePath)
         {
-            if (i + 2 >= len || (bytes[i + 1] & 0xC0) != 0x80 || (bytes[i + 2] & 0xC0) != 0x80)
-                return false;
+            std::filesystem::path fullPath =
+                (gameRoot / std::filesystem::path(std::u8string(relativePath.begin(), relativePath.end())))
+                    .lexically_normal();
+            std::error_code fileError;
+            if (GameSandbox::Contains(fullPath) && std::filesystem::is_regular_file(fullPath, fileError) &&
+                addedFiles.insert(DirectoryScanner::FoldCase(fullPath.wstring())).second)
+            {
+                files.emplace_back(std::move(name), std::move(fullPath));
+            }
+        };
 
-            if (bytes[i] == 0xE0 && (bytes[i + 1] < 0xA0))
-                return false;
-            if (bytes[i] == 0xED && (bytes[i + 1] >= 0xA0))
-                return false;
+        std::string latestRed4extLog;
+        uint64_t latestWriteTime = 0;
+        DirectoryScanner::Enumerate(gameRoot / "red4ext" / "logs",
+                                    [&latestRed4extLog, &latestWriteTime](std::wstring&& name,
+                                                                         const DirectoryScanner::Entry& entry)
+                                    {
+                                        std::wstring folded = DirectoryScanner::FoldCase(name);
+                                        if (!entry.IsDirectory() && folded.starts_with(L"RED4EXT") &&
+                                            folded.ends_with(L".LOG") && entry.lastWriteTime >= latestWriteTime)
+                                        {
+                                            latestWriteTime = entry.lastWriteTime;
+                                            latestRed4extLog = std::filesystem::path(name).generic_string();
+                                        }
+                                    });
 
-            i += 3;
-            continue;
+        if (!latestRed4extLog.empty())
+        {
+            addFile("logs/" + latestRed4extLog, "red4ext/logs/" + latestRed4extLog);
         }
 
-        if (bytes[i] >= 0xF0 && bytes[i] <= 0xF4)
+        for (const char* log : BUNDLE_LOGS)
         {
-            if (i + 3 >= len || (bytes[i + 1] & 0xC0) != 0x80 || (bytes[i + 2] & 0xC0) != 0x80 ||
-                (bytes[i + 3] & 0xC0) != 0x80)
-                return false;
+            addFile(std::string("logs/") + std::filesystem::path(log).filename().string(), log);
+        }
 
-            if (bytes[i] == 0xF0 && (bytes[i + 1] < 0x90))
-                return false;
-            if (bytes[i] == 0xF4 && (bytes[i + 1] >= 0x90))
-                return false;
+        for (const auto& extraFile : options.extraFiles)
+        {
+            // The path becomes the entry name, so one with ".." could be unpacked outside the extraction folder.
+            std::string relativePath = normalizePathString(extraFile);
+            if (isSafeEntryPath(relativePath))
+            {
+                addFile("files/" + relativePath, relativePath);
+            }
+        }
 
-            i += 4;
-            continue;
+        uint64_t totalBytes = 0;
+        for (const auto& [name, path] : files)
+        {
+            std::error_code sizeError;
+            auto size = std::filesystem::file_size(path, sizeError);
+            totalBytes += sizeError ? 0 : size;
         }
 
-        return false;
+        // The module list, the install state and its diff are the three generated entries.
+        job.SetTotals(totalBytes, static_cast<uint32_t>(files.size() + 3));
+
+        std::filesystem::path temporaryPath = outputPath;
+        temporaryPath += ".tmp";
+        ZipWriter zip;
+        if (!zip.Open(temporaryPath))
+        {
+            return FILE_WRITE_FAIL;
+        }
+
+        zip.AddBuffer("modules.txt", GameModules::DescribeLoadedModules());
+        job.AddFiles(1);
+
+        // The saved file already holds this session's baseline; changes are counted from the previous session.
+        std::vector<InstallState::Entry> saved;
+        bool hasSavedState =
+            InstallState::GetPreviousState(resolveOutputPath(gameRoot, InstallState::STATE_PATH), saved);
+        std::vector<InstallState::Entry> current;
+        InstallState::Capture(gameRoot, &saved, false, DiagnosticsScheduler::ThreadBudget(0), current, &job);
+        zip.AddBuffer("installState.paths", InstallState::Serialize(current));
+        job.AddFiles(1);
+
+        if (hasSavedState)
+        {
+            std::vector<InstallState::Difference> differences;
+            InstallState::Diff(saved, current, differences);
+
+            std::string changes;
+            for (const auto& difference : differences)
+            {
+                changes += InstallState::ToString(difference.change);
+                changes += " | " + difference.path + " | " + std::to_string(difference.sizeBefore) + " | " +
+                           std::to_string(difference.sizeAfter) + "\n";
+            }
+
+            zip.AddBuffer("installChanges.txt", changes);
+        }
+
+        job.AddFiles(1);
+
+        for (const auto& [name, path] : files)
+        {
+            // A log that vanished or is locked is skipped; the rest of the bundle is still useful.
+            zip.AddFile(name, path, &job);
+            job.AddFiles(1);
+
+            if (job.IsCancelled())
+            {
+                break;
+            }
+        }
+
+        bool isWritten = zip.Close();
+        if (job.IsCancelled() || !isWritten)
+        {
+            std::filesystem::remove(temporaryPath, ec);
+
+            return job.IsCancelled() ? JOB_CANCELLED : FILE_WRITE_FAIL;
+        }
+
+        std::filesystem::rename(temporaryPath, outputPath, ec);
+
+        return ec ? FILE_WRITE_FAIL : std::string();
     }
+    catch (const std::exception& e)
+    {
+        std::string errorMsg = "Exception: ";
+        errorMsg += e.what();
 
-    return true;
+        return errorMsg;
+    }
+}
+
+std::string CyberlibsCore::GameDiagnosticsAsync::diffInstallState(bool hashFiles, DiagnosticsJob& job,
+                                                                 Red::DynArray<GameDiagnosticsInstallChange>& changes)
+{
+    try
+    {
+        auto gamePath = GameDiagnostics::GetGamePath();
+        if (gamePath.Length() == 0)
+        {
+            return INVALID_GAME_PATH;
+        }
+
+        const std::filesystem::path gameRoot = std::filesystem::path(gamePath.c_str()).lexically_normal();
+
+        std::vector<InstallState::Entry> previous;
+        if (!InstallState::GetPreviousState(resolveOutputPath(gameRoot, InstallState::STATE_PATH), previous))
+        {
+            return NO_INSTALL_STATE;
+        }
+
+        // Unchanged files take their hash from the previous state, so only touched files are ever read.
+        std::vector<InstallState::Entry> current;
+        InstallState::Capture(gameRoot, &previous, hashFiles, DiagnosticsScheduler::ThreadBudget(0), current,
+                              &job);
+        if (job.IsCancelled())
+        {
+            return JOB_CANCELLED;
+        }
+
+        std::vector<InstallState::Difference> differences;
+        InstallState::Diff(previous, current, differences);
+
+        changes.Reserve(static_cast<uint32_t>(differences.size()));
+        for (const auto& difference : differences)
+        {
+            GameDiagnosticsInstallChange change;
+            change.path = Red::CString(difference.path.c_str());
+            change.change = Red::CString(InstallState::ToString(difference.change));
+            change.sizeBefore = difference.sizeBefore;
+            change.sizeAfter = difference.sizeAfter;
+            changes.PushBack(change);
+        }
+
+        return std::string();
+    }
+    catch (const std::exception& e)
+    {
+        std::string errorMsg = "Exception: ";
+        errorMsg += e.what();
+
+        return errorMsg;
+    }
+}
+
+std::string CyberlibsCore::GameDiagnosticsAsync::readArchiveIndexes(
+    const Red::DynArray<Red::CString>& relativePaths, bool includeResources, DiagnosticsJob& job,
+    Red::DynArray<GameDiagnosticsArchiveInfo>& archives)
+{
+    try
+    {
+        if (!GameDiagnostics::LoadArchiveIndexes(relativePaths, includeResources, archives, &job))
+        {
+            return INVALID_GAME_PATH;
+        }
+
+        return job.IsCancelled() ? JOB_CANCELLED : std::string();
+    }
+    catch (const std::exception& e)
+    {
+        std::string errorMsg = "Exception: ";
+        errorMsg += e.what();
+
+        return errorMsg;
+    }
+}
+
+std::string CyberlibsCore::GameDiagnosticsAsync::inFlightKey(const Red::CString& relativePath)
+{
+    // Windows paths are case-insensitive, so "Archive/PC" and "archive/pc" must share one job.
+    std::string key = std::filesystem::path(normalizePathString(relativePath)).lexically_normal().generic_string();
+    std::transform(key.begin(), key.end(), key.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+
+    return key;
+}
+
+std::string CyberlibsCore::GameDiagnosticsAsync::formatFileTime(const std::filesystem::file_time_type& fileTime)
+{
+    auto systemTime = std::chrono::time_point_cast<std::chrono::system_clock::duration>(
+        std::chrono::file_clock::to_sys(fileTime));
+    auto time = std::chrono::system_clock::to_time_t(systemTime);
+    std::stringstream ss;
+    ss << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S");
+
+    return ss.str();
 }
 
 std::string CyberlibsCore::GameDiagnosticsAsync::normalizePathString(std::string path)
@@ -277,81 +982,136 @@ std::string CyberlibsCore::GameDiagnosticsAsync::normalizePathString(std::string
     return path;
 }
 
-std::vector<CyberlibsCore::GameDiagnosticsAsync::LineValidation> CyberlibsCore::GameDiagnosticsAsync::readLines(
-    const std::filesystem::path& path)
+bool CyberlibsCore::GameDiagnosticsAsync::isSafeEntryPath(std::string_view path)
 {
-    std::vector<LineValidation> lines;
-    std::ifstream file(path, std::ios::in | std::ios::binary);
-    if (!file.is_open())
+    if (path.empty())
     {
-        return lines;
+        return false;
     }
 
-    std::string line;
-    while (std::getline(file, line))
+    size_t start = 0;
+    while (start <= path.size())
     {
-        if (!line.empty() && line.back() == '\r')
+        size_t end = path.find('/', start);
+        std::string_view component = path.substr(start, end == std::string_view::npos ? end : end - start);
+        if (component.empty() || component == "." || component == ".." ||
+            component.find(':') != std::string_view::npos)
         {
-            line.pop_back();
+            return false;
         }
 
-        if (line.empty() || line[0] == '#')
+        if (end == std::string_view::npos)
         {
-            continue;
+            break;
         }
 
-        size_t start = line.find_first_not_of(" \t");
-        if (start == std::string::npos)
-        {
-            continue;
-        }
+        start = end + 1;
+    }
 
-        size_t end = line.find_last_not_of(" \t");
-        line = line.substr(start, end - start + 1);
+    return true;
+}
 
-        LineValidation validation;
-        validation.expectedHash = "";
-        if (line[0] == '!')
-        {
-            validation.shouldExist = false;
-            line = line.substr(1);
-            start = line.find_first_not_of(" \t");
-            if (start != std::string::npos)
-            {
-                end = line.find_last_not_of(" \t");
-                line = line.substr(start, end - start + 1);
-            }
-        }
-        else
+std::filesystem::path CyberlibsCore::GameDiagnosticsAsync::resolveOutputPath(const std::filesystem::path& gameRoot,
+                                                                           const std::string& relativePath)
+{
+    std::filesystem::path basePath = (gameRoot / "_DIAGNOSTICS").lexically_normal();
+    std::filesystem::path fullPath =
+        (basePath / std::filesystem::path(std::u8string(relativePath.begin(), relativePath.end()))).lexically_normal();
+    if (fullPath == basePath || !GameSandbox::IsWithin(basePath, fullPath) || !GameSandbox::Contains(fullPath))
+    {
+        return std::filesystem::path();
+    }
+
+    return fullPath;
+}
+
+std::filesystem::path CyberlibsCore::GameDiagnosticsAsync::resolveFilePath(const Red::CString& relativeFilePath)
+{
+    auto gamePath = GameDiagnostics::GetGamePath();
+    if (gamePath.Length() == 0)
+    {
+        return std::filesystem::path();
+    }
+
+    std::string normalizedPath = normalizePathString(relativeFilePath);
+    std::filesystem::path fullPath = std::filesystem::path(gamePath.c_str()) / normalizedPath;
+    fullPath = fullPath.lexically_normal();
+    if (!GameSandbox::Contains(fullPath) || !std::filesystem::exists(fullPath) ||
+        !std::filesystem::is_regular_file(fullPath))
+    {
+        return std::filesystem::path();
+    }
+
+    return fullPath;
+}
+
+bool CyberlibsCore::GameDiagnosticsAsync::verifyPaths(const Red::CString& relativePathsFilePath, bool verifyHashes,
+                                                      bool stopOnFirstMismatch, DiagnosticsJob& job)
+{
+    try
+    {
+        MappedFile pathsFile;
+        std::vector<PathsParser::Record> records;
+        std::filesystem::path gameRoot;
+        if (!GameDiagnostics::LoadPaths(relativePathsFilePath, pathsFile, records, gameRoot))
         {
-            validation.shouldExist = true;
+            return false;
         }
 
-        size_t pipePos = line.find('|');
-        if (pipePos != std::string::npos)
-        {
-            validation.path = line.substr(0, pipePos);
-            end = validation.path.find_last_not_of(" \t");
-            validation.path = validation.path.substr(0, end + 1);
+        job.SetTotals(0, static_cast<uint32_t>(records.size()));
 
-            std::string hash = line.substr(pipePos + 1);
-            start = hash.find_first_not_of(" \t");
-            if (start != std::string::npos)
-            {
-                end = hash.find_last_not_of(" \t");
-                validation.expectedHash = hash.substr(start, end - start + 1);
-            }
-        }
-        else
+        PathsVerifier::Options verifyOptions;
+        verifyOptions.maxThreads = DiagnosticsScheduler::ThreadBudget(0);
+        verifyOptions.verifyHashes = verifyHashes;
+        verifyOptions.stopOnFirstFailure = stopOnFirstMismatch;
+        verifyOptions.job = &job;
+
+        return PathsVerifier::Verify(gameRoot, records, verifyOptions);
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
+
+std::string CyberlibsCore::GameDiagnosticsAsync::verifyPathsReport(const Red::CString& relativePathsFilePath,
+                                                                   bool verifyHashes, DiagnosticsJob& job,
+                                                                   Red::DynArray<GameDiagnosticsPathsFailure>& report)
+{
+    try
+    {
+        MappedFile pathsFile;
+        std::vector<PathsParser::Record> records;
+        std::filesystem::path gameRoot;
+        if (!GameDiagnostics::LoadPaths(relativePathsFilePath, pathsFile, records, gameRoot))
         {
-            validation.path = line;
+            return INVALID_PATHS_FILE;
         }
 
-        if (!validation.path.empty())
+        job.SetTotals(0, static_cast<uint32_t>(records.size()));
+
+        PathsVerifier::Options verifyOptions;
+        verifyOptions.maxThreads = DiagnosticsScheduler::ThreadBudget(0);
+        verifyOptions.verifyHashes = verifyHashes;
+        verifyOptions.stopOnFirstFailure = false;
+        verifyOptions.job = &job;
+
+        std::vector<PathsVerifier::Failure> failures;
+        PathsVerifier::Verify(gameRoot, records, verifyOptions, &failures);
+        if (job.IsCancelled())
         {
-            lines.push_back(validation);
+            return JOB_CANCELLED;
         }
+
+        GameDiagnostics::AppendPathsFailures(records, failures, report);
+
+        return std::string();
     }
+    catch (const std::exception& e)
+    {
+        std::string errorMsg = "Exception: ";
+        errorMsg += e.what();
 
-    return lines;
+        return errorMsg;
+    }
 }
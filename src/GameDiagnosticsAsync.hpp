@@ -3,9 +3,25 @@
 #include <RED4ext/RED4ext.hpp>
 #include <RedLib.hpp>
 #include <sha256.h>
+#include "ChunkedHash.hpp"
+#include "DiagnosticsJobs.hpp"
+#include "DiagnosticsScheduler.hpp"
+#include "DirectoryScanner.hpp"
+#include "FileReader.hpp"
+#include "InFlightJobs.hpp"
+#include "InstallState.hpp"
+#include "MappedFile.hpp"
+#include "PathsParser.hpp"
+#include "PathsVerifier.hpp"
 #include "GameDiagnostics.hpp"
+#include "GameSandbox.hpp"
+#include "WorkStealingPool.hpp"
+#include "ZipWriter.hpp"
 
+#include <cctype>
 #include <string>
+#include <string_view>
+#include <unordered_set>
 #include <vector>
 #include <chrono>
 #include <filesystem>
@@ -15,12 +31,48 @@
 
 namespace CyberlibsCore
 {
+// Default picks the class that suits the call: interactive for single files, background for bulk jobs.
+enum class GameDiagnosticsPriority
+{
+    Default,
+    Interactive,
+    Background,
+    Idle
+};
+
+struct GameDiagnosticsSchedulerStats
+{
+public:
+    int32_t interactiveQueued;
+    int32_t interactiveRunning;
+    uint64_t interactiveCompleted;
+    int32_t backgroundQueued;
+    int32_t backgroundRunning;
+    uint64_t backgroundCompleted;
+    int32_t idleQueued;
+    int32_t idleRunning;
+    uint64_t idleCompleted;
+    int32_t concurrency;
+};
+
+struct GameDiagnosticsJobProgress
+{
+public:
+    uint64_t handle;
+    uint64_t bytesDone;
+    uint64_t bytesTotal;
+    int32_t filesDone;
+    int32_t filesTotal;
+};
+
 struct GameDiagnosticsHashPromise
 {
 public:
     Red::WeakHandle<Red::IScriptable> target;
     Red::CName onSuccess;
     Red::CName onError;
+    Red::CName onProgress;
+    GameDiagnosticsPriority priority;
     Red::CString filePath;
 
     void Success(const Red::CString& hash) const
@@ -38,6 +90,14 @@ public:
 
         Red::CallVirtual(target.Lock(), onError, err, filePath);
     }
+
+    void Progress(const GameDiagnosticsJobProgress& progress) const
+    {
+        if (target.Expired() || onProgress.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onProgress, progress, filePath);
+    }
 };
 
 struct GameDiagnosticsVerifyPathsPromise
@@ -45,6 +105,9 @@ struct GameDiagnosticsVerifyPathsPromise
 public:
     Red::WeakHandle<Red::IScriptable> target;
     Red::CName onComplete;
+    Red::CName onError;
+    Red::CName onProgress;
+    GameDiagnosticsPriority priority;
     Red::CString filePath;
 
     void Resolve(bool isValid) const
@@ -54,52 +117,486 @@ public:
 
         Red::CallVirtual(target.Lock(), onComplete, isValid, filePath);
     }
+
+    void Error(const Red::CString& err) const
+    {
+        if (target.Expired() || onError.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onError, err, filePath);
+    }
+
+    void Progress(const GameDiagnosticsJobProgress& progress) const
+    {
+        if (target.Expired() || onProgress.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onProgress, progress, filePath);
+    }
+};
+
+struct GameDiagnosticsVerifyPathsReportPromise
+{
+public:
+    Red::WeakHandle<Red::IScriptable> target;
+    Red::CName onComplete;
+    Red::CName onError;
+    Red::CName onProgress;
+    GameDiagnosticsPriority priority;
+    Red::CString filePath;
+
+    void Resolve(const Red::DynArray<GameDiagnosticsPathsFailure>& failures) const
+    {
+        if (target.Expired())
+            return;
+
+        Red::CallVirtual(target.Lock(), onComplete, failures, filePath);
+    }
+
+    void Error(const Red::CString& err) const
+    {
+        if (target.Expired() || onError.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onError, err, filePath);
+    }
+
+    void Progress(const GameDiagnosticsJobProgress& progress) const
+    {
+        if (target.Expired() || onProgress.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onProgress, progress, filePath);
+    }
+};
+
+struct GameDiagnosticsByteRange
+{
+public:
+    uint64_t offset;
+    uint64_t size;
+};
+
+struct GameDiagnosticsChunkHashOptions
+{
+public:
+    int32_t chunkSize;
+    int32_t maxThreads;
+    bool bypassCache;
+    Red::CString outputFilePath;
+};
+
+struct GameDiagnosticsChunkHashPromise
+{
+public:
+    Red::WeakHandle<Red::IScriptable> target;
+    Red::CName onSuccess;
+    Red::CName onError;
+    Red::CName onProgress;
+    GameDiagnosticsPriority priority;
+    Red::CString filePath;
+
+    void Success(const Red::CString& rootHash, const Red::CString& manifestPath) const
+    {
+        if (target.Expired())
+            return;
+
+        Red::CallVirtual(target.Lock(), onSuccess, rootHash, manifestPath, filePath);
+    }
+
+    void Error(const Red::CString& err) const
+    {
+        if (target.Expired() || onError.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onError, err, filePath);
+    }
+
+    void Progress(const GameDiagnosticsJobProgress& progress) const
+    {
+        if (target.Expired() || onProgress.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onProgress, progress, filePath);
+    }
+};
+
+struct GameDiagnosticsChunkVerifyOptions
+{
+public:
+    int32_t maxThreads;
+    bool bypassCache;
+    Red::DynArray<GameDiagnosticsByteRange> changedRanges;
+};
+
+struct GameDiagnosticsChunkVerifyPromise
+{
+public:
+    Red::WeakHandle<Red::IScriptable> target;
+    Red::CName onComplete;
+    Red::CName onError;
+    Red::CName onProgress;
+    GameDiagnosticsPriority priority;
+    Red::CString filePath;
+
+    void Resolve(bool isValid, const Red::DynArray<GameDiagnosticsByteRange>& mismatches) const
+    {
+        if (target.Expired())
+            return;
+
+        Red::CallVirtual(target.Lock(), onComplete, isValid, mismatches, filePath);
+    }
+
+    void Error(const Red::CString& err) const
+    {
+        if (target.Expired() || onError.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onError, err, filePath);
+    }
+
+    void Progress(const GameDiagnosticsJobProgress& progress) const
+    {
+        if (target.Expired() || onProgress.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onProgress, progress, filePath);
+    }
+};
+
+struct GameDiagnosticsHashDirectoryOptions
+{
+public:
+    int32_t maxThreads;
+    bool bypassCache;
+    bool includeMetadata;
+    Red::CString outputFilePath;
+};
+
+struct GameDiagnosticsHashDirectoryPromise
+{
+public:
+    Red::WeakHandle<Red::IScriptable> target;
+    Red::CName onSuccess;
+    Red::CName onError;
+    Red::CName onProgress;
+    GameDiagnosticsPriority priority;
+    Red::CString relativePath;
+
+    // failedFiles lists the files that could not be read; they are in the manifest without a hash.
+    void Success(const Red::CString& manifestPath, const Red::DynArray<Red::CString>& failedFiles) const
+    {
+        if (target.Expired())
+            return;
+
+        Red::CallVirtual(target.Lock(), onSuccess, manifestPath, failedFiles, relativePath);
+    }
+
+    void Error(const Red::CString& err) const
+    {
+        if (target.Expired() || onError.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onError, err, relativePath);
+    }
+
+    void Progress(const GameDiagnosticsJobProgress& progress) const
+    {
+        if (target.Expired() || onProgress.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onProgress, progress, relativePath);
+    }
+};
+
+struct GameDiagnosticsBundleOptions
+{
+public:
+    // Game-relative files to add under files/ in the archive. Paths with "..", "." or empty components are skipped.
+    Red::DynArray<Red::CString> extraFiles;
+    Red::CString outputFilePath;
+};
+
+struct GameDiagnosticsBundlePromise
+{
+public:
+    Red::WeakHandle<Red::IScriptable> target;
+    Red::CName onSuccess;
+    Red::CName onError;
+    Red::CName onProgress;
+    GameDiagnosticsPriority priority;
+
+    void Success(const Red::CString& bundlePath) const
+    {
+        if (target.Expired())
+            return;
+
+        Red::CallVirtual(target.Lock(), onSuccess, bundlePath);
+    }
+
+    void Error(const Red::CString& err) const
+    {
+        if (target.Expired() || onError.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onError, err);
+    }
+
+    void Progress(const GameDiagnosticsJobProgress& progress) const
+    {
+        if (target.Expired() || onProgress.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onProgress, progress);
+    }
+};
+
+struct GameDiagnosticsInstallDiffPromise
+{
+public:
+    Red::WeakHandle<Red::IScriptable> target;
+    Red::CName onSuccess;
+    Red::CName onError;
+    Red::CName onProgress;
+    GameDiagnosticsPriority priority;
+
+    void Success(const Red::DynArray<GameDiagnosticsInstallChange>& changes) const
+    {
+        if (target.Expired())
+            return;
+
+        Red::CallVirtual(target.Lock(), onSuccess, changes);
+    }
+
+    void Error(const Red::CString& err) const
+    {
+        if (target.Expired() || onError.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onError, err);
+    }
+
+    void Progress(const GameDiagnosticsJobProgress& progress) const
+    {
+        if (target.Expired() || onProgress.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onProgress, progress);
+    }
+};
+
+struct GameDiagnosticsArchiveIndexesPromise
+{
+public:
+    Red::WeakHandle<Red::IScriptable> target;
+    Red::CName onSuccess;
+    Red::CName onError;
+    Red::CName onProgress;
+    GameDiagnosticsPriority priority;
+
+    void Success(const Red::DynArray<GameDiagnosticsArchiveInfo>& archives) const
+    {
+        if (target.Expired())
+            return;
+
+        Red::CallVirtual(target.Lock(), onSuccess, archives);
+    }
+
+    void Error(const Red::CString& err) const
+    {
+        if (target.Expired() || onError.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onError, err);
+    }
+
+    void Progress(const GameDiagnosticsJobProgress& progress) const
+    {
+        if (target.Expired() || onProgress.IsNone())
+            return;
+
+        Red::CallVirtual(target.Lock(), onProgress, progress);
+    }
 };
 
 struct GameDiagnosticsAsync : Red::IScriptable
 {
 public:
-    void GetFileHash(const Red::CString& relativeFilePath, const GameDiagnosticsHashPromise& promise);
-    void VerifyPaths(const Red::CString& relativePathsFilePath,
-                                 const GameDiagnosticsVerifyPathsPromise& promise);
+    bool Cancel(uint64_t handle);
+    // Zips the module list, the install state and its changes since the last session, and the latest RED4ext,
+    // redscript and CET logs into one archive under _DIAGNOSTICS.
+    uint64_t CreateBundle(const GameDiagnosticsBundleOptions& options, const GameDiagnosticsBundlePromise& promise);
+    // Compares the previous session's install state with the mod folders as they are now. With hashFiles, files
+    // whose write time changed but whose size did not are hashed, so only real content changes are reported.
+    uint64_t DiffInstallState(const GameDiagnosticsInstallDiffPromise& promise, Red::Optional<bool> hashFiles);
+    GameDiagnosticsJobProgress GetProgress(uint64_t handle);
+    GameDiagnosticsSchedulerStats GetSchedulerStats();
+    uint64_t GetFileHash(const Red::CString& relativeFilePath, const GameDiagnosticsHashPromise& promise,
+                         Red::Optional<bool> bypassCache);
+    uint64_t HashDirectory(const Red::CString& relativePath, const GameDiagnosticsHashDirectoryOptions& options,
+                           const GameDiagnosticsHashDirectoryPromise& promise);
+    uint64_t HashFileChunks(const Red::CString& relativeFilePath, const GameDiagnosticsChunkHashOptions& options,
+                            const GameDiagnosticsChunkHashPromise& promise);
+    // GameDiagnostics::ReadArchiveIndexes off the game thread. Progress counts archives.
+    uint64_t ReadArchiveIndexes(const Red::DynArray<Red::CString>& relativePaths,
+                                const GameDiagnosticsArchiveIndexesPromise& promise,
+                                Red::Optional<bool> includeResources);
+    uint64_t VerifyFileChunks(const Red::CString& relativeFilePath, const Red::CString& relativeManifestPath,
+                              const GameDiagnosticsChunkVerifyOptions& options,
+                              const GameDiagnosticsChunkVerifyPromise& promise);
+    uint64_t VerifyPaths(const Red::CString& relativePathsFilePath, const GameDiagnosticsVerifyPathsPromise& promise,
+                         Red::Optional<bool> verifyHashes, Red::Optional<bool> stopOnFirstMismatch);
+    uint64_t VerifyPathsReport(const Red::CString& relativePathsFilePath,
+                               const GameDiagnosticsVerifyPathsReportPromise& promise,
+                               Red::Optional<bool> verifyHashes);
 
     RTTI_IMPL_TYPEINFO(CyberlibsCore::GameDiagnosticsAsync);
     RTTI_IMPL_ALLOCATOR();
 
 private:
-    struct LineValidation
+    struct ManifestEntry
     {
         std::string path;
-        bool shouldExist;
-        std::string expectedHash;
+        uint64_t size;
+        std::string lastWriteTime;
+        std::string hash;
     };
 
     static constexpr size_t MAX_INPUT_FILE_SIZE = 5 * 1024 * 1024;
-    static constexpr size_t MAX_OUTPUT_FILE_SIZE = 5 * 1024 * 1024;
+    static constexpr const char* BUNDLE_LOGS[] = {"r6/logs/redscript_rCURRENT.log",
+                                                  "bin/x64/plugins/cyber_engine_tweaks/cyber_engine_tweaks.log",
+                                                  "bin/x64/plugins/cyber_engine_tweaks/scripting.log"};
     static constexpr const char* FILE_LOCKED = "File locked";
     static constexpr const char* FILE_READ_FAIL = "Failed to read file";
+    static constexpr const char* INVALID_MANIFEST = "Invalid chunk manifest";
+    static constexpr const char* FILE_WRITE_FAIL = "Failed to write file";
     static constexpr const char* INVALID_GAME_PATH = "Invalid game path";
+    static constexpr const char* NO_INSTALL_STATE = "No saved install state";
+    static constexpr const char* INVALID_PATHS_FILE = "Invalid paths file";
+    static constexpr const char* JOB_CANCELLED = "Cancelled";
     static constexpr const char* UNKNOWN_VALUE = "Unknown";
     static constexpr const char* VALID_TEXT_EXTENSIONS[] = {".txt", ".log", ".md"};
 
-    static bool isPathSafe(const std::filesystem::path& path);
-    static bool isValidUtf8(const std::string& str);
+    template<typename Promise>
+    static std::shared_ptr<DiagnosticsJob> createJob(const Promise& promise)
+    {
+        auto job = DiagnosticsJobs::Create();
+        if (!promise.onProgress.IsNone())
+        {
+            job->SetReporter([promise](const DiagnosticsJob::Progress& progress)
+                             { promise.Progress(toJobProgress(progress)); });
+        }
+
+        return job;
+    }
+
+    // Rejects work the scheduler dropped on shutdown before it started.
+    template<typename Promise>
+    static DiagnosticsScheduler::Work dropJob(const Promise& promise, const std::shared_ptr<DiagnosticsJob>& job)
+    {
+        return [promise, job]() -> void
+        {
+            DiagnosticsJobs::Release(*job);
+            promise.Error(JOB_CANCELLED);
+        };
+    }
+
+    template<typename Promise>
+    static DiagnosticsScheduler::Work dropGroup(InFlightJobs<Promise>& jobs,
+                                                const std::shared_ptr<typename InFlightJobs<Promise>::Group>& group)
+    {
+        return [&jobs, group]() -> void
+        {
+            auto subscribers = jobs.Complete(group);
+            for (const auto& subscriber : subscribers)
+            {
+                if (DiagnosticsJobs::IsSubscribed(subscriber.handle))
+                {
+                    subscriber.promise.Error(JOB_CANCELLED);
+                }
+            }
+            DiagnosticsJobs::Release(*group->job);
+        };
+    }
+
+    static DiagnosticsScheduler::Priority toSchedulerPriority(GameDiagnosticsPriority priority,
+                                                              DiagnosticsScheduler::Priority fallback);
+    static GameDiagnosticsJobProgress toJobProgress(const DiagnosticsJob::Progress& progress);
+
+    template<typename Promise>
+    static void notifyProgress(const Promise& promise, const DiagnosticsJob::Progress& progress)
+    {
+        promise.Progress(toJobProgress(progress));
+    }
+
+    static inline InFlightJobs<GameDiagnosticsHashPromise> hashJobs_{notifyProgress<GameDiagnosticsHashPromise>};
+    static inline InFlightJobs<GameDiagnosticsVerifyPathsPromise> verifyPathsJobs_{
+        notifyProgress<GameDiagnosticsVerifyPathsPromise>};
+    static inline InFlightJobs<GameDiagnosticsVerifyPathsReportPromise> verifyPathsReportJobs_{
+        notifyProgress<GameDiagnosticsVerifyPathsReportPromise>};
+
+    static std::string hashFile(const Red::CString& relativeFilePath, bool bypassCache, DiagnosticsJob& job,
+                                std::string& hash);
+    static bool verifyPaths(const Red::CString& relativePathsFilePath, bool verifyHashes, bool stopOnFirstMismatch,
+                            DiagnosticsJob& job);
+    static std::string verifyPathsReport(const Red::CString& relativePathsFilePath, bool verifyHashes,
+                                         DiagnosticsJob& job, Red::DynArray<GameDiagnosticsPathsFailure>& report);
+    static std::string createBundle(const GameDiagnosticsBundleOptions& options, DiagnosticsJob& job,
+                                    std::string& bundlePath);
+    static std::string diffInstallState(bool hashFiles, DiagnosticsJob& job,
+                                        Red::DynArray<GameDiagnosticsInstallChange>& changes);
+    static std::string readArchiveIndexes(const Red::DynArray<Red::CString>& relativePaths, bool includeResources,
+                                          DiagnosticsJob& job, Red::DynArray<GameDiagnosticsArchiveInfo>& archives);
+    static std::string inFlightKey(const Red::CString& relativePath);
+    static std::string formatFileTime(const std::filesystem::file_time_type& fileTime);
+    static std::filesystem::path resolveOutputPath(const std::filesystem::path& gameRoot,
+                                                   const std::string& relativePath);
+    static std::filesystem::path resolveFilePath(const Red::CString& relativeFilePath);
     static std::string normalizePathString(std::string path);
     inline static std::string normalizePathString(const Red::CString& path)
     {
         return normalizePathString(std::string(path.c_str()));
     }
-
-    static std::vector<LineValidation> readLines(const std::filesystem::path& path);
+    // A '/' separated relative path without empty, "." or ".." components or drive colons.
+    static bool isSafeEntryPath(std::string_view path);
 };
 } // namespace CyberlibsCore
 
+RTTI_DEFINE_ENUM(CyberlibsCore::GameDiagnosticsPriority);
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsSchedulerStats, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsSchedulerStats");
+
+    RTTI_PROPERTY(interactiveQueued);
+    RTTI_PROPERTY(interactiveRunning);
+    RTTI_PROPERTY(interactiveCompleted);
+    RTTI_PROPERTY(backgroundQueued);
+    RTTI_PROPERTY(backgroundRunning);
+    RTTI_PROPERTY(backgroundCompleted);
+    RTTI_PROPERTY(idleQueued);
+    RTTI_PROPERTY(idleRunning);
+    RTTI_PROPERTY(idleCompleted);
+    RTTI_PROPERTY(concurrency);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsJobProgress, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsJobProgress");
+
+    RTTI_PROPERTY(handle);
+    RTTI_PROPERTY(bytesDone);
+    RTTI_PROPERTY(bytesTotal);
+    RTTI_PROPERTY(filesDone);
+    RTTI_PROPERTY(filesTotal);
+});
+
 RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsHashPromise, {
     RTTI_ALIAS("CyberlibsCore.GameDiagnosticsHashPromise");
 
     RTTI_PROPERTY(target);
     RTTI_PROPERTY(onSuccess, "success");
     RTTI_PROPERTY(onError, "error");
+    RTTI_PROPERTY(onProgress, "progress");
+    RTTI_PROPERTY(priority);
     RTTI_PROPERTY(filePath);
 });
 
@@ -108,12 +605,139 @@ RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsVerifyPathsPromise, {
 
     RTTI_PROPERTY(target);
     RTTI_PROPERTY(onComplete, "complete");
+    RTTI_PROPERTY(onError, "error");
+    RTTI_PROPERTY(onProgress, "progress");
+    RTTI_PROPERTY(priority);
+    RTTI_PROPERTY(filePath);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsVerifyPathsReportPromise, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsVerifyPathsReportPromise");
+
+    RTTI_PROPERTY(target);
+    RTTI_PROPERTY(onComplete, "complete");
+    RTTI_PROPERTY(onError, "error");
+    RTTI_PROPERTY(onProgress, "progress");
+    RTTI_PROPERTY(priority);
+    RTTI_PROPERTY(filePath);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsByteRange, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsByteRange");
+
+    RTTI_PROPERTY(offset);
+    RTTI_PROPERTY(size);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsChunkHashOptions, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsChunkHashOptions");
+
+    RTTI_PROPERTY(chunkSize);
+    RTTI_PROPERTY(maxThreads);
+    RTTI_PROPERTY(bypassCache);
+    RTTI_PROPERTY(outputFilePath);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsChunkHashPromise, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsChunkHashPromise");
+
+    RTTI_PROPERTY(target);
+    RTTI_PROPERTY(onSuccess, "success");
+    RTTI_PROPERTY(onError, "error");
+    RTTI_PROPERTY(onProgress, "progress");
+    RTTI_PROPERTY(priority);
+    RTTI_PROPERTY(filePath);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsChunkVerifyOptions, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsChunkVerifyOptions");
+
+    RTTI_PROPERTY(maxThreads);
+    RTTI_PROPERTY(bypassCache);
+    RTTI_PROPERTY(changedRanges);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsChunkVerifyPromise, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsChunkVerifyPromise");
+
+    RTTI_PROPERTY(target);
+    RTTI_PROPERTY(onComplete, "complete");
+    RTTI_PROPERTY(onError, "error");
+    RTTI_PROPERTY(onProgress, "progress");
+    RTTI_PROPERTY(priority);
     RTTI_PROPERTY(filePath);
 });
 
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsHashDirectoryOptions, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsHashDirectoryOptions");
+
+    RTTI_PROPERTY(maxThreads);
+    RTTI_PROPERTY(bypassCache);
+    RTTI_PROPERTY(includeMetadata);
+    RTTI_PROPERTY(outputFilePath);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsHashDirectoryPromise, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsHashDirectoryPromise");
+
+    RTTI_PROPERTY(target);
+    RTTI_PROPERTY(onSuccess, "success");
+    RTTI_PROPERTY(onError, "error");
+    RTTI_PROPERTY(onProgress, "progress");
+    RTTI_PROPERTY(priority);
+    RTTI_PROPERTY(relativePath);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsBundleOptions, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsBundleOptions");
+
+    RTTI_PROPERTY(extraFiles);
+    RTTI_PROPERTY(outputFilePath);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsBundlePromise, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsBundlePromise");
+
+    RTTI_PROPERTY(target);
+    RTTI_PROPERTY(onSuccess, "success");
+    RTTI_PROPERTY(onError, "error");
+    RTTI_PROPERTY(onProgress, "progress");
+    RTTI_PROPERTY(priority);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsInstallDiffPromise, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsInstallDiffPromise");
+
+    RTTI_PROPERTY(target);
+    RTTI_PROPERTY(onSuccess, "success");
+    RTTI_PROPERTY(onError, "error");
+    RTTI_PROPERTY(onProgress, "progress");
+    RTTI_PROPERTY(priority);
+});
+
+RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsArchiveIndexesPromise, {
+    RTTI_ALIAS("CyberlibsCore.GameDiagnosticsArchiveIndexesPromise");
+
+    RTTI_PROPERTY(target);
+    RTTI_PROPERTY(onSuccess, "success");
+    RTTI_PROPERTY(onError, "error");
+    RTTI_PROPERTY(onProgress, "progress");
+    RTTI_PROPERTY(priority);
+});
+
 RTTI_DEFINE_CLASS(CyberlibsCore::GameDiagnosticsAsync, {
     RTTI_ALIAS("CyberlibsCore.GameDiagnosticsAsync");
 
+    RTTI_METHOD(Cancel);
+    RTTI_METHOD(CreateBundle);
+    RTTI_METHOD(DiffInstallState);
+    RTTI_METHOD(GetProgress);
+    RTTI_METHOD(GetSchedulerStats);
     RTTI_METHOD(GetFileHash);
+    RTTI_METHOD(HashDirectory);
+    RTTI_METHOD(HashFileChunks);
+    RTTI_METHOD(ReadArchiveIndexes);
+    RTTI_METHOD(VerifyFileChunks);
     RTTI_METHOD(VerifyPaths);
+    RTTI_METHOD(VerifyPathsReport);
 });
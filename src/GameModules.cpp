@@ -119,7 +119,8 @@ Red::CString CyberlibsCore::GameModules::GetEntryPoint(const Red::CString& fileN
 }
 
 // Export
-Red::DynArray<CyberlibsCore::GameModulesExportEntry> CyberlibsCore::GameModules::GetExport(const Red::CString& fileNameOrPath)
+Red::DynArray<CyberlibsCore::GameModulesExportEntry> CyberlibsCore::GameModules::GetExport(
+    const Red::CString& fileNameOrPath)
 {
     Red::DynArray<GameModulesExportEntry> result;
 
@@ -305,7 +306,8 @@ Red::CString CyberlibsCore::GameModules::GetFileType(const Red::CString& fileNam
 }
 
 // Import
-Red::DynArray<CyberlibsCore::GameModulesImportEntry> CyberlibsCore::GameModules::GetImport(const Red::CString& fileNameOrPath)
+Red::DynArray<CyberlibsCore::GameModulesImportEntry> CyberlibsCore::GameModules::GetImport(
+    const Red::CString& fileNameOrPath)
 {
     Red::DynArray<GameModulesImportEntry> result;
 
@@ -564,23 +566,9 @@ Red::CString CyberlibsCore::GameModules::GetVersion(const Red::CString& fileName
             return UNKNOWN_VALUE;
         }
 
-        UINT size = 0;
-        VS_FIXEDFILEINFO* verInfo = nullptr;
-        if (!VerQueryValueW(verData.data(), L"\\", (VOID FAR * FAR*)&verInfo, &size))
-        {
-            return UNKNOWN_VALUE;
-        }
-
-        if (size < sizeof(VS_FIXEDFILEINFO) || verInfo->dwSignature != 0xfeef04bd)
-        {
-            return UNKNOWN_VALUE;
-        }
-
-        char szVersion[32];
-        sprintf_s(szVersion, "%d.%d.%d.%d", HIWORD(verInfo->dwFileVersionMS), LOWORD(verInfo->dwFileVersionMS),
-                  HIWORD(verInfo->dwFileVersionLS), LOWORD(verInfo->dwFileVersionLS));
+        std::string version = formatFileVersion(verData);
 
-        return Red::CString(szVersion);
+        return version.empty() ? Red::CString(UNKNOWN_VALUE) : Red::CString(version.c_str());
     }
     catch (...)
     {
@@ -606,6 +594,50 @@ bool CyberlibsCore::GameModules::IsLoaded(const Red::CString& fileNameOrPath)
     return isLoaded;
 }
 
+// Loaded Modules Description
+std::string CyberlibsCore::GameModules::DescribeLoadedModules()
+{
+    std::string text;
+
+    try
+    {
+        HANDLE hProcess = GetCurrentProcess();
+        std::vector<HMODULE> hModules(1024);
+        DWORD cbNeeded = 0;
+        if (!EnumProcessModulesEx(hProcess, hModules.data(), static_cast<DWORD>(hModules.size() * sizeof(HMODULE)),
+                                  &cbNeeded, LIST_MODULES_ALL))
+        {
+            return text;
+        }
+
+        hModules.resize((std::min)(hModules.size(), static_cast<size_t>(cbNeeded / sizeof(HMODULE))));
+        for (HMODULE hModule : hModules)
+        {
+            wchar_t wFilePath[32768];
+            DWORD length = GetModuleFileNameW(hModule, wFilePath, sizeof(wFilePath) / sizeof(wchar_t));
+            if (length == 0 || length >= sizeof(wFilePath) / sizeof(wchar_t))
+            {
+                continue;
+            }
+
+            std::wstring filePath(wFilePath, length);
+            std::string version = formatFileVersion(getVersionInfo(filePath));
+
+            text += wideCharToRedString(std::filesystem::path(filePath).filename().wstring()).c_str();
+            text += " | ";
+            text += version.empty() ? UNKNOWN_VALUE : version;
+            text += " | ";
+            text += wideCharToRedString(filePath).c_str();
+            text += "\n";
+        }
+    }
+    catch (...)
+    {
+    }
+
+    return text;
+}
+
 // Private Helpers
 
 bool CyberlibsCore::GameModules::checkRateLimit()
@@ -729,6 +761,27 @@ std::vector<BYTE> CyberlibsCore::GameModules::getVersionInfoCached(const std::ws
     return verData;
 }
 
+std::string CyberlibsCore::GameModules::formatFileVersion(const std::vector<BYTE>& verData)
+{
+    UINT size = 0;
+    VS_FIXEDFILEINFO* verInfo = nullptr;
+    if (verData.empty() || !VerQueryValueW(verData.data(), L"\\", (VOID FAR * FAR*)&verInfo, &size))
+    {
+        return std::string();
+    }
+
+    if (size < sizeof(VS_FIXEDFILEINFO) || verInfo->dwSignature != 0xfeef04bd)
+    {
+        return std::string();
+    }
+
+    char szVersion[32];
+    sprintf_s(szVersion, "%d.%d.%d.%d", HIWORD(verInfo->dwFileVersionMS), LOWORD(verInfo->dwFileVersionMS),
+              HIWORD(verInfo->dwFileVersionLS), LOWORD(verInfo->dwFileVersionLS));
+
+    return szVersion;
+}
+
 Red::CString CyberlibsCore::GameModules::getVersionInfoString(const std::vector<BYTE>& verData, const wchar_t* key)
 {
     LPVOID lpBuffer = nullptr;
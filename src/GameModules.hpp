@@ -3,6 +3,8 @@
 #include <RED4ext/RED4ext.hpp>
 #include <RedLib.hpp>
 
+#include <algorithm>
+#include <filesystem>
 #include <string>
 #include <vector>
 #include <chrono>
@@ -48,6 +50,9 @@ public:
     static Red::CString GetTimeDateStamp(const Red::CString& fileNameOrPath, Red::Optional<bool> pathFriendly);
     static Red::CString GetVersion(const Red::CString& fileNameOrPath);
     static bool IsLoaded(const Red::CString& fileNameOrPath);
+    // One "name | version | path" line per loaded module, for native callers such as diagnostics bundles. Reads the
+    // process directly, without the rate limit and cache the script API goes through.
+    static std::string DescribeLoadedModules();
 
     RTTI_IMPL_TYPEINFO(CyberlibsCore::GameModules);
     RTTI_IMPL_ALLOCATOR();
@@ -104,6 +109,8 @@ private:
     static std::wstring resolvePath(const Red::CString& moduleFileOrPath);
     static std::vector<BYTE> getVersionInfo(const std::wstring& modulePath);
     static std::vector<BYTE> getVersionInfoCached(const std::wstring& modulePath);
+    // "major.minor.build.revision" from the fixed file info, or an empty string.
+    static std::string formatFileVersion(const std::vector<BYTE>& verData);
     static Red::CString getVersionInfoString(const std::vector<BYTE>& verData, const wchar_t* key);
     static Red::CString wideCharToRedString(const std::wstring& wide);
 
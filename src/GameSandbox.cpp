@@ -0,0 +1,204 @@
+#include "GameSandbox.hpp"
+#include "DirectoryScanner.hpp"
+
+#include <iterator>
+#include <string>
+#include <vector>
+
+const std::filesystem::path& CyberlibsCore::GameSandbox::Root()
+{
+    std::call_once(initialized_, initialize);
+
+    return root_;
+}
+
+bool CyberlibsCore::GameSandbox::Contains(const std::filesystem::path& path)
+{
+    return check(path, false);
+}
+
+bool CyberlibsCore::GameSandbox::ContainsDirectory(const std::filesystem::path& directory)
+{
+    return check(directory, true);
+}
+
+bool CyberlibsCore::GameSandbox::IsWithin(const std::filesystem::path& base, const std::filesystem::path& path)
+{
+    std::filesystem::path normalizedBase = base.lexically_normal();
+    std::filesystem::path normalizedPath = path.lexically_normal();
+
+    auto pathIt = normalizedPath.begin();
+    for (const auto& component : normalizedBase)
+    {
+        // "C:\Games\" normalises with a trailing empty component, which matches anything.
+        if (component.empty())
+        {
+            continue;
+        }
+
+        if (pathIt == normalizedPath.end() ||
+            DirectoryScanner::FoldCase(pathIt->wstring()) != DirectoryScanner::FoldCase(component.wstring()))
+        {
+            return false;
+        }
+
+        ++pathIt;
+    }
+
+    return true;
+}
+
+// Private Helpers
+
+void CyberlibsCore::GameSandbox::initialize()
+{
+    std::wstring buffer(32768, L'\0');
+    DWORD length = GetModuleFileNameW(NULL, buffer.data(), static_cast<DWORD>(buffer.size()));
+    if (length == 0 || length >= buffer.size())
+    {
+        return;
+    }
+
+    buffer.resize(length);
+
+    // <game>/bin/x64/Cyberpunk2077.exe
+    root_ = std::filesystem::path(buffer).lexically_normal().parent_path().parent_path().parent_path();
+    rootDepth_ = std::distance(root_.begin(), root_.end());
+
+    finalRoot_ = finalPath(root_);
+    if (finalRoot_.empty())
+    {
+        finalRoot_ = root_;
+    }
+}
+
+bool CyberlibsCore::GameSandbox::check(const std::filesystem::path& path, bool cacheLeaf)
+{
+    const auto& root = Root();
+    std::filesystem::path normalizedPath = path.lexically_normal();
+    if (root.empty() || !IsWithin(root, normalizedPath))
+    {
+        return false;
+    }
+
+    // Every prefix of the path below the root, shallowest first.
+    std::vector<std::filesystem::path> prefixes;
+    std::filesystem::path current = root;
+    auto it = normalizedPath.begin();
+    std::advance(it, rootDepth_);
+    for (; it != normalizedPath.end(); ++it)
+    {
+        if (!it->empty())
+        {
+            current /= *it;
+            prefixes.push_back(current);
+        }
+    }
+
+    // The leaf of a plain Contains is always queried, since it may be a file that is replaced at any time.
+    size_t cachedCount = cacheLeaf || prefixes.empty() ? prefixes.size() : prefixes.size() - 1;
+    size_t first = 0;
+    {
+        std::shared_lock lock(cacheMutex_);
+        auto now = std::chrono::steady_clock::now();
+        for (size_t i = cachedCount; i > 0; --i)
+        {
+            auto cached = directories_.find(DirectoryScanner::FoldCase(prefixes[i - 1].wstring()));
+            if (cached != directories_.end() && now - cached->second.checkedAt < CACHE_LIFETIME)
+            {
+                if (!cached->second.isContained)
+                {
+                    return false;
+                }
+
+                first = i;
+                break;
+            }
+        }
+    }
+
+    for (size_t i = first; i < prefixes.size(); ++i)
+    {
+        Verdict verdict = checkComponent(prefixes[i]);
+        if (verdict == Verdict::Missing)
+        {
+            // Nothing under a missing component can exist either.
+            return true;
+        }
+
+        if (i < cachedCount)
+        {
+            remember(prefixes[i], verdict == Verdict::Inside);
+        }
+
+        if (verdict == Verdict::Outside)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+CyberlibsCore::GameSandbox::Verdict CyberlibsCore::GameSandbox::checkComponent(const std::filesystem::path& path)
+{
+    DWORD attributes = GetFileAttributesW(path.c_str());
+    if (attributes == INVALID_FILE_ATTRIBUTES)
+    {
+        return Verdict::Missing;
+    }
+
+    // Below the root, only a reparse point can lead somewhere else.
+    if ((attributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0)
+    {
+        return Verdict::Inside;
+    }
+
+    std::filesystem::path target = finalPath(path);
+    return !target.empty() && IsWithin(finalRoot_, target) ? Verdict::Inside : Verdict::Outside;
+}
+
+void CyberlibsCore::GameSandbox::remember(const std::filesystem::path& directory, bool isContained)
+{
+    std::unique_lock lock(cacheMutex_);
+    if (directories_.size() >= MAX_CACHED_DIRECTORIES)
+    {
+        directories_.clear();
+    }
+
+    directories_[DirectoryScanner::FoldCase(directory.wstring())] = {isContained, std::chrono::steady_clock::now()};
+}
+
+std::filesystem::path CyberlibsCore::GameSandbox::finalPath(const std::filesystem::path& path)
+{
+    // Backup semantics are needed to open a directory at all.
+    HANDLE file = CreateFileW(path.c_str(), 0, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                              OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return std::filesystem::path();
+    }
+
+    std::wstring buffer(32768, L'\0');
+    DWORD length = GetFinalPathNameByHandleW(file, buffer.data(), static_cast<DWORD>(buffer.size()),
+                                             FILE_NAME_NORMALIZED | VOLUME_NAME_DOS);
+    CloseHandle(file);
+    if (length == 0 || length >= buffer.size())
+    {
+        return std::filesystem::path();
+    }
+
+    buffer.resize(length);
+
+    // The result always carries the \\?\ prefix, which the game root never has.
+    if (buffer.starts_with(L"\\\\?\\UNC\\"))
+    {
+        buffer = L"\\\\" + buffer.substr(8);
+    }
+    else if (buffer.starts_with(L"\\\\?\\"))
+    {
+        buffer = buffer.substr(4);
+    }
+
+    return std::filesystem::path(buffer).lexically_normal();
+}
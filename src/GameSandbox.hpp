@@ -0,0 +1,64 @@
+#pragma once
+
+#include <windows.h>
+
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+
+namespace CyberlibsCore
+{
+// The one place that decides whether a path belongs to the game directory. The root is resolved from the executable
+// once per process. Checks compare whole path components, so "Cyberpunk 2077 backup" is not inside "Cyberpunk 2077",
+// and a symlink or junction under the root passes only if its target is inside the root too. Verdicts for the
+// directories above a path are remembered for a few seconds, so checking many paths costs about one attribute query
+// each; a directory swapped for a link within that window passes until its verdict expires.
+class GameSandbox
+{
+public:
+    // The game directory as the executable sees it; empty if it cannot be determined.
+    static const std::filesystem::path& Root();
+    static bool Contains(const std::filesystem::path& path);
+    // Contains for a directory that many paths are about to be checked under; its own verdict is remembered too.
+    static bool ContainsDirectory(const std::filesystem::path& directory);
+    // Case-insensitive and component-wise; both paths are compared lexically normalised. A path is within itself.
+    static bool IsWithin(const std::filesystem::path& base, const std::filesystem::path& path);
+
+private:
+    static constexpr std::chrono::seconds CACHE_LIFETIME{5};
+    static constexpr size_t MAX_CACHED_DIRECTORIES = 4096;
+
+    enum class Verdict
+    {
+        Inside,
+        Outside,
+        Missing
+    };
+
+    struct CachedDirectory
+    {
+        bool isContained;
+        std::chrono::steady_clock::time_point checkedAt;
+    };
+
+    static void initialize();
+    static bool check(const std::filesystem::path& path, bool cacheLeaf);
+    static Verdict checkComponent(const std::filesystem::path& path);
+    static void remember(const std::filesystem::path& directory, bool isContained);
+    // The target of path with every link resolved, or an empty path if it cannot be opened.
+    static std::filesystem::path finalPath(const std::filesystem::path& path);
+
+    static inline std::once_flag initialized_;
+    static inline std::filesystem::path root_;
+    // Link targets are compared against this, since the root itself may sit behind a link.
+    static inline std::filesystem::path finalRoot_;
+    static inline size_t rootDepth_ = 0;
+
+    static inline std::shared_mutex cacheMutex_;
+    // Keyed by the case-folded directory path.
+    static inline std::unordered_map<std::wstring, CachedDirectory> directories_;
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,196 @@
+#include "GlobPattern.hpp"
+#include "DirectoryScanner.hpp"
+
+#include <algorithm>
+#include <filesystem>
+
+bool CyberlibsCore::GlobPattern::Compile(std::string_view pattern)
+{
+    segments_.clear();
+
+    // Patterns come from UTF-8 manifests; a plain std::string would be read in the ANSI code page on Windows.
+    std::wstring text = std::filesystem::path(std::u8string(pattern.begin(), pattern.end())).wstring();
+    std::replace(text.begin(), text.end(), L'\\', L'/');
+
+    size_t start = 0;
+    while (start <= text.size())
+    {
+        size_t end = text.find(L'/', start);
+        if (end == std::wstring::npos)
+        {
+            end = text.size();
+        }
+
+        std::wstring segment = text.substr(start, end - start);
+        start = end + 1;
+
+        if (segment.empty() || segment == L".")
+        {
+            continue;
+        }
+
+        if (segment == L".." || segment.find(L':') != std::wstring::npos)
+        {
+            segments_.clear();
+            return false;
+        }
+
+        bool isRecursive = segment == L"**";
+        if (isRecursive && !segments_.empty() && segments_.back().isRecursive)
+        {
+            continue;
+        }
+
+        segments_.push_back({DirectoryScanner::FoldCase(std::move(segment)), isRecursive});
+    }
+
+    return !segments_.empty();
+}
+
+bool CyberlibsCore::GlobPattern::Matches(const std::vector<std::wstring>& components) const
+{
+    // Simulate the segment automaton: states are indices into segments_, with "**" staying active across components.
+    std::vector<bool> states(segments_.size() + 1, false);
+    std::vector<bool> next(segments_.size() + 1, false);
+    states[0] = true;
+
+    auto closeOverRecursive = [this](std::vector<bool>& set)
+    {
+        for (size_t i = 0; i < segments_.size(); ++i)
+        {
+            if (set[i] && segments_[i].isRecursive)
+            {
+                set[i + 1] = true;
+            }
+        }
+    };
+
+    closeOverRecursive(states);
+
+    for (const auto& component : components)
+    {
+        std::fill(next.begin(), next.end(), false);
+        for (size_t i = 0; i < segments_.size(); ++i)
+        {
+            if (!states[i])
+            {
+                continue;
+            }
+
+            if (segments_[i].isRecursive)
+            {
+                next[i] = true;
+            }
+            else if (MatchSegment(segments_[i].text, component))
+            {
+                next[i + 1] = true;
+            }
+        }
+
+        closeOverRecursive(next);
+        states.swap(next);
+    }
+
+    return states[segments_.size()];
+}
+
+bool CyberlibsCore::GlobPattern::MatchSegment(std::wstring_view pattern, std::wstring_view name)
+{
+    // Greedy matching that only ever backtracks to the last '*', which keeps it linear for the patterns manifests
+    // actually use.
+    size_t p = 0;
+    size_t n = 0;
+    size_t starPattern = std::wstring_view::npos;
+    size_t starName = 0;
+
+    while (n < name.size())
+    {
+        if (p < pattern.size() && pattern[p] == L'*')
+        {
+            starPattern = p++;
+            starName = n;
+            continue;
+        }
+
+        size_t next = p;
+        if (p < pattern.size() && matchCharacter(pattern, next, name[n]))
+        {
+            p = next;
+            ++n;
+            continue;
+        }
+
+        if (starPattern == std::wstring_view::npos)
+        {
+            return false;
+        }
+
+        p = starPattern + 1;
+        n = ++starName;
+    }
+
+    while (p < pattern.size() && pattern[p] == L'*')
+    {
+        ++p;
+    }
+
+    return p == pattern.size();
+}
+
+// Private Helpers
+
+bool CyberlibsCore::GlobPattern::matchCharacter(std::wstring_view pattern, size_t& position, wchar_t c)
+{
+    wchar_t first = pattern[position];
+    if (first == L'?')
+    {
+        ++position;
+        return true;
+    }
+
+    size_t close = std::wstring_view::npos;
+    if (first == L'[')
+    {
+        size_t i = position + 1;
+        if (i < pattern.size() && (pattern[i] == L'!' || pattern[i] == L'^'))
+        {
+            ++i;
+        }
+
+        // A ']' right after the opening bracket is part of the class.
+        close = pattern.find(L']', i + 1);
+    }
+
+    if (close == std::wstring_view::npos)
+    {
+        // Not a class, or an unterminated one: the character stands for itself.
+        ++position;
+        return first == c;
+    }
+
+    size_t i = position + 1;
+    bool negated = pattern[i] == L'!' || pattern[i] == L'^';
+    if (negated)
+    {
+        ++i;
+    }
+
+    bool found = false;
+    while (i < close)
+    {
+        if (i + 2 < close && pattern[i + 1] == L'-')
+        {
+            found = found || (c >= pattern[i] && c <= pattern[i + 2]);
+            i += 3;
+        }
+        else
+        {
+            found = found || c == pattern[i];
+            ++i;
+        }
+    }
+
+    position = close + 1;
+
+    return found != negated;
+}
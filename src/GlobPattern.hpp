@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// A path pattern split into case-folded segments. Within a segment '*' matches any run of characters, '?' one
+// character and [abc], [a-z] or [!a-z] one character from (or outside) a class. A segment that is exactly "**"
+// matches any number of directories.
+class GlobPattern
+{
+public:
+    struct Segment
+    {
+        std::wstring text;
+        bool isRecursive;
+    };
+
+    // Accepts '/' or '\' separators. Returns false for empty patterns and patterns that would leave the root they
+    // are matched against ("..", drive letters).
+    bool Compile(std::string_view pattern);
+    // Matches a relative path given as case-folded components.
+    bool Matches(const std::vector<std::wstring>& components) const;
+
+    const std::vector<Segment>& GetSegments() const
+    {
+        return segments_;
+    }
+
+    // Both arguments must be case-folded the same way.
+    static bool MatchSegment(std::wstring_view pattern, std::wstring_view name);
+
+private:
+    static bool matchCharacter(std::wstring_view pattern, size_t& position, wchar_t c);
+
+    std::vector<Segment> segments_;
+};
+} // namespace CyberlibsCore
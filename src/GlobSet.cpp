@@ -0,0 +1,143 @@
+#include "GlobSet.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <memory>
+
+void CyberlibsCore::GlobSet::Add(GlobPattern pattern, uint32_t maxCount)
+{
+    rules_.push_back({std::move(pattern), maxCount});
+}
+
+void CyberlibsCore::GlobSet::Count(const std::filesystem::path& root, uint32_t maxThreads, DiagnosticsJob* job,
+                                   std::vector<uint32_t>& counts) const
+{
+    auto matches = std::make_unique<std::atomic<uint32_t>[]>(rules_.size());
+    auto isSettled = [this, &matches](uint32_t rule)
+    { return matches[rule].load(std::memory_order_relaxed) > rules_[rule].maxCount; };
+
+    std::vector<Frontier> level(1);
+    level[0].directory = root;
+    for (uint32_t i = 0; i < rules_.size(); ++i)
+    {
+        level[0].states.push_back({i, 0});
+    }
+
+    while (!level.empty() && !(job && job->IsCancelled()))
+    {
+        std::vector<std::vector<Frontier>> nextLevels(level.size());
+
+        WorkStealingPool::Run(level.size(), maxThreads,
+                              [&](size_t index)
+                              {
+                                  if (job && job->IsCancelled())
+                                  {
+                                      return;
+                                  }
+
+                                  auto& frontier = level[index];
+                                  std::erase_if(frontier.states,
+                                                [&isSettled](const State& state) { return isSettled(state.rule); });
+                                  if (frontier.states.empty())
+                                  {
+                                      return;
+                                  }
+
+                                  DirectoryScanner::Listing listing;
+                                  if (!DirectoryScanner::List(frontier.directory, listing))
+                                  {
+                                      return;
+                                  }
+
+                                  std::vector<State> childStates;
+                                  std::vector<uint32_t> matched;
+                                  for (const auto& [name, entry] : listing)
+                                  {
+                                      bool isDirectory = entry.IsDirectory() &&
+                                                         (entry.attributes & FILE_ATTRIBUTE_REPARSE_POINT) == 0;
+                                      childStates.clear();
+                                      matched.clear();
+
+                                      for (const auto& state : frontier.states)
+                                      {
+                                          advance(state, name, isDirectory, childStates, matched);
+                                      }
+
+                                      // "**" can reach the same entry more than once; it still counts once.
+                                      std::sort(matched.begin(), matched.end());
+                                      matched.erase(std::unique(matched.begin(), matched.end()), matched.end());
+                                      for (uint32_t rule : matched)
+                                      {
+                                          matches[rule].fetch_add(1, std::memory_order_relaxed);
+                                      }
+
+                                      if (!childStates.empty())
+                                      {
+                                          std::sort(childStates.begin(), childStates.end());
+                                          childStates.erase(std::unique(childStates.begin(), childStates.end()),
+                                                            childStates.end());
+                                          nextLevels[index].push_back({frontier.directory / name, childStates});
+                                      }
+                                  }
+                              });
+
+        level.clear();
+        for (auto& frontiers : nextLevels)
+        {
+            std::move(frontiers.begin(), frontiers.end(), std::back_inserter(level));
+        }
+    }
+
+    counts.resize(rules_.size());
+    for (size_t i = 0; i < rules_.size(); ++i)
+    {
+        counts[i] = (std::min)(matches[i].load(), rules_[i].maxCount == UINT32_MAX ? UINT32_MAX
+                                                                                    : rules_[i].maxCount + 1);
+    }
+}
+
+// Private Helpers
+
+void CyberlibsCore::GlobSet::advance(State state, const std::wstring& name, bool isDirectory,
+                                     std::vector<State>& childStates, std::vector<uint32_t>& matched) const
+{
+    const auto& segments = rules_[state.rule].pattern.GetSegments();
+    const auto& segment = segments[state.segment];
+    bool isLast = state.segment + 1 == segments.size();
+
+    if (segment.isRecursive)
+    {
+        // "**" consumes this entry and stays active below it, or matches nothing and hands the entry on.
+        if (isLast)
+        {
+            matched.push_back(state.rule);
+        }
+        else
+        {
+            advance({state.rule, state.segment + 1}, name, isDirectory, childStates, matched);
+        }
+
+        if (isDirectory)
+        {
+            childStates.push_back(state);
+        }
+
+        return;
+    }
+
+    if (!GlobPattern::MatchSegment(segment.text, name))
+    {
+        return;
+    }
+
+    if (isLast)
+    {
+        matched.push_back(state.rule);
+    }
+    else if (isDirectory)
+    {
+        childStates.push_back({state.rule, state.segment + 1});
+    }
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "DiagnosticsJobs.hpp"
+#include "DirectoryScanner.hpp"
+#include "GlobPattern.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Counts the entries matched by many glob patterns in one walk of the tree. All patterns advance together as a
+// single automaton, so every directory is listed at most once no matter how many patterns reach it, and
+// directories no pattern can reach are never listed at all. Each level of the tree is scanned in parallel.
+class GlobSet
+{
+public:
+    // Matching for a pattern stops once its count passes maxCount, since the result can no longer change.
+    void Add(GlobPattern pattern, uint32_t maxCount);
+
+    size_t Size() const
+    {
+        return rules_.size();
+    }
+
+    // counts[i] is the number of files and directories under root matched by the i-th pattern, clamped to
+    // maxCount + 1. Reparse points are not followed.
+    void Count(const std::filesystem::path& root, uint32_t maxThreads, DiagnosticsJob* job,
+               std::vector<uint32_t>& counts) const;
+
+private:
+    struct Rule
+    {
+        GlobPattern pattern;
+        uint32_t maxCount;
+    };
+
+    struct State
+    {
+        uint32_t rule;
+        uint32_t segment;
+
+        bool operator<(const State& other) const
+        {
+            return rule != other.rule ? rule < other.rule : segment < other.segment;
+        }
+
+        bool operator==(const State& other) const
+        {
+            return rule == other.rule && segment == other.segment;
+        }
+    };
+
+    struct Frontier
+    {
+        std::filesystem::path directory;
+        std::vector<State> states;
+    };
+
+    void advance(State state, const std::wstring& name, bool isDirectory, std::vector<State>& childStates,
+                 std::vector<uint32_t>& matched) const;
+
+    std::vector<Rule> rules_;
+};
+} // namespace CyberlibsCore
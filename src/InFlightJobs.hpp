@@ -0,0 +1,122 @@
+#pragma once
+
+#include "DiagnosticsJobs.hpp"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Lets concurrent requests for the same work share one running job. The first caller for a key becomes the leader
+// and dispatches the work; later callers only subscribe and are resolved together with it.
+template<typename Promise>
+class InFlightJobs
+{
+public:
+    struct Subscriber
+    {
+        uint64_t handle;
+        Promise promise;
+    };
+
+    struct Group
+    {
+        std::string key;
+        std::shared_ptr<DiagnosticsJob> job;
+        std::vector<Subscriber> subscribers;
+    };
+
+    struct Attachment
+    {
+        std::shared_ptr<Group> group;
+        uint64_t handle;
+        bool isLeader;
+    };
+
+    using Notifier = std::function<void(const Promise& promise, const DiagnosticsJob::Progress& progress)>;
+
+    explicit InFlightJobs(Notifier notifier)
+        : notifier_(std::move(notifier))
+    {
+    }
+
+    Attachment Attach(const std::string& key, const Promise& promise)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = groups_.find(key);
+        if (it != groups_.end())
+        {
+            uint64_t handle = DiagnosticsJobs::Subscribe(it->second->job);
+            if (handle != 0)
+            {
+                it->second->subscribers.push_back({handle, promise});
+
+                return {it->second, handle, false};
+            }
+        }
+
+        // Either nothing is running for the key or every earlier subscriber cancelled, so start over.
+        auto group = std::make_shared<Group>();
+        group->key = key;
+        group->job = DiagnosticsJobs::Create();
+        group->subscribers.push_back({group->job->GetHandle(), promise});
+
+        std::weak_ptr<Group> weakGroup = group;
+        group->job->SetReporter([this, weakGroup](const DiagnosticsJob::Progress& progress)
+                                { report(weakGroup, progress); });
+
+        groups_[key] = group;
+
+        return {group, group->job->GetHandle(), true};
+    }
+
+    // Closes the group to new subscribers and returns everyone waiting on it. Subscribers that cancelled are
+    // included; check DiagnosticsJobs::IsSubscribed and skip them, a cancelled handle gets no further callbacks.
+    std::vector<Subscriber> Complete(const std::shared_ptr<Group>& group)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = groups_.find(group->key);
+        if (it != groups_.end() && it->second == group)
+        {
+            groups_.erase(it);
+        }
+
+        return group->subscribers;
+    }
+
+private:
+    void report(const std::weak_ptr<Group>& weakGroup, DiagnosticsJob::Progress progress)
+    {
+        auto group = weakGroup.lock();
+        if (!group)
+        {
+            return;
+        }
+
+        std::vector<Subscriber> subscribers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            subscribers = group->subscribers;
+        }
+
+        for (const auto& subscriber : subscribers)
+        {
+            if (DiagnosticsJobs::IsSubscribed(subscriber.handle))
+            {
+                progress.handle = subscriber.handle;
+                notifier_(subscriber.promise, progress);
+            }
+        }
+    }
+
+    Notifier notifier_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::shared_ptr<Group>> groups_;
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,329 @@
+#include "InstallState.hpp"
+#include "GameSandbox.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+
+void CyberlibsCore::InstallState::Capture(const std::filesystem::path& gameRoot, const std::vector<Entry>* previous,
+                                          bool hashFiles, uint32_t maxThreads, std::vector<Entry>& entries,
+                                          DiagnosticsJob* job)
+{
+    entries.clear();
+
+    DirectoryWalker::Options walkOptions;
+    walkOptions.includeDirectories = false;
+    walkOptions.maxThreads = maxThreads;
+    walkOptions.job = job;
+    for (const char* pattern : EXCLUDED)
+    {
+        GlobPattern glob;
+        glob.Compile(pattern);
+        walkOptions.exclude.push_back(std::move(glob));
+    }
+
+    std::vector<DirectoryWalker::Entry> walked;
+    for (const char* directory : DIRECTORIES)
+    {
+        if (job && job->IsCancelled())
+        {
+            return;
+        }
+
+        // The walk never descends into links, so only the top-level folder and linked files need checking.
+        if (!GameSandbox::ContainsDirectory(gameRoot / directory) ||
+            !DirectoryWalker::Walk(gameRoot / directory, walkOptions, walked))
+        {
+            continue;
+        }
+
+        for (auto& file : walked)
+        {
+            Entry entry;
+            entry.path = std::string(directory) + "/" + file.relativePath;
+            if ((file.info.attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0 &&
+                !GameSandbox::Contains(gameRoot / std::u8string(entry.path.begin(), entry.path.end())))
+            {
+                continue;
+            }
+
+            entry.key = makeKey(entry.path);
+            entry.size = file.info.size;
+            entry.lastWriteTime = file.info.lastWriteTime;
+            entries.push_back(std::move(entry));
+        }
+    }
+
+    sortByKey(entries);
+
+    if (previous)
+    {
+        // Both sides are sorted by key, so carrying hashes over is a single merge.
+        auto it = previous->begin();
+        for (auto& entry : entries)
+        {
+            while (it != previous->end() && it->key < entry.key)
+            {
+                ++it;
+            }
+
+            if (it != previous->end() && it->key == entry.key && it->size == entry.size &&
+                it->lastWriteTime == entry.lastWriteTime)
+            {
+                entry.hash = it->hash;
+            }
+        }
+    }
+
+    if (!hashFiles || (job && job->IsCancelled()))
+    {
+        return;
+    }
+
+    std::vector<Entry*> pending;
+    uint64_t pendingBytes = 0;
+    for (auto& entry : entries)
+    {
+        if (entry.hash.empty())
+        {
+            pending.push_back(&entry);
+            pendingBytes += entry.size;
+        }
+    }
+
+    if (job)
+    {
+        job->SetTotals(pendingBytes, static_cast<uint32_t>(pending.size()));
+    }
+
+    // Largest files first, so one huge archive does not start last and hold up the whole pool.
+    std::sort(pending.begin(), pending.end(), [](const Entry* a, const Entry* b) { return a->size > b->size; });
+
+    FileReader::Options readOptions;
+    readOptions.job = job;
+    WorkStealingPool::Run(pending.size(), maxThreads,
+                          [&](size_t index)
+                          {
+                              if (job && job->IsCancelled())
+                              {
+                                  return;
+                              }
+
+                              auto& entry = *pending[index];
+                              std::filesystem::path fullPath =
+                                  gameRoot / std::u8string(entry.path.begin(), entry.path.end());
+                              std::string hash;
+                              if (FileReader::HashFile(fullPath, readOptions, hash) == FileReader::Status::Ok)
+                              {
+                                  entry.hash = std::move(hash);
+                              }
+
+                              if (job)
+                              {
+                                  job->AddFiles(1);
+                              }
+                          });
+}
+
+bool CyberlibsCore::InstallState::Save(const std::filesystem::path& file, const std::vector<Entry>& entries)
+{
+    std::string text = Serialize(entries);
+
+    // Write next to the old state and swap, so a crash mid-write never leaves a truncated state behind.
+    std::filesystem::path temporaryFile = file;
+    temporaryFile += ".tmp";
+    {
+        std::ofstream stream(temporaryFile, std::ios::out | std::ios::binary | std::ios::trunc);
+        if (!stream.is_open())
+        {
+            return false;
+        }
+
+        stream.write(text.data(), text.size());
+        if (!stream)
+        {
+            return false;
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(temporaryFile, file, ec);
+
+    return !ec;
+}
+
+std::string CyberlibsCore::InstallState::Serialize(const std::vector<Entry>& entries)
+{
+    std::string text = HEADER;
+    text.reserve(entries.size() * 128);
+    for (const auto& entry : entries)
+    {
+        text += entry.path;
+        text += " | ";
+        text += entry.hash;
+        text += " | ";
+        text += std::to_string(entry.size);
+        text += " | ";
+        text += std::to_string(entry.lastWriteTime);
+        text += '\n';
+    }
+
+    return text;
+}
+
+bool CyberlibsCore::InstallState::Load(const std::filesystem::path& file, std::vector<Entry>& entries)
+{
+    entries.clear();
+
+    MappedFile stateFile;
+    std::vector<PathsParser::Record> records;
+    if (!stateFile.Open(file, MAX_STATE_SIZE) || !PathsParser::Parse(stateFile.View(), records))
+    {
+        return false;
+    }
+
+    entries.reserve(records.size());
+    for (const auto& record : records)
+    {
+        if (!record.shouldExist || record.isPattern)
+        {
+            continue;
+        }
+
+        Entry entry{};
+        entry.path = record.path;
+        entry.key = makeKey(entry.path);
+        entry.hash = record.hash;
+        std::from_chars(record.size.data(), record.size.data() + record.size.size(), entry.size);
+        std::from_chars(record.lastWriteTime.data(), record.lastWriteTime.data() + record.lastWriteTime.size(),
+                        entry.lastWriteTime);
+        entries.push_back(std::move(entry));
+    }
+
+    // Saved states are already sorted; a hand-edited one may not be.
+    if (!std::is_sorted(entries.begin(), entries.end(),
+                        [](const Entry& a, const Entry& b) { return a.key < b.key; }))
+    {
+        sortByKey(entries);
+    }
+
+    return true;
+}
+
+void CyberlibsCore::InstallState::Diff(const std::vector<Entry>& before, const std::vector<Entry>& after,
+                                       std::vector<Difference>& differences)
+{
+    differences.clear();
+
+    auto oldIt = before.begin();
+    auto newIt = after.begin();
+    while (oldIt != before.end() || newIt != after.end())
+    {
+        if (newIt == after.end() || (oldIt != before.end() && oldIt->key < newIt->key))
+        {
+            differences.push_back({Change::Removed, oldIt->path, oldIt->size, 0});
+            ++oldIt;
+            continue;
+        }
+
+        if (oldIt == before.end() || newIt->key < oldIt->key)
+        {
+            differences.push_back({Change::Added, newIt->path, 0, newIt->size});
+            ++newIt;
+            continue;
+        }
+
+        bool sameContent = !oldIt->hash.empty() && oldIt->hash == newIt->hash;
+        if (oldIt->size != newIt->size || (oldIt->lastWriteTime != newIt->lastWriteTime && !sameContent))
+        {
+            differences.push_back({Change::Modified, newIt->path, oldIt->size, newIt->size});
+        }
+
+        ++oldIt;
+        ++newIt;
+    }
+}
+
+const char* CyberlibsCore::InstallState::ToString(Change change)
+{
+    switch (change)
+    {
+    case Change::Added:
+        return "added";
+    case Change::Removed:
+        return "removed";
+    case Change::Modified:
+        return "modified";
+    }
+
+    return "unknown";
+}
+
+bool CyberlibsCore::InstallState::BeginSession(const std::filesystem::path& gameRoot, const std::filesystem::path& file,
+                                               uint32_t maxThreads)
+{
+    std::vector<Entry> previous;
+    bool hasPrevious = Load(file, previous);
+
+    std::vector<Entry> baseline;
+    Capture(gameRoot, hasPrevious ? &previous : nullptr, false, maxThreads, baseline);
+
+    std::vector<Difference> differences;
+    if (hasPrevious)
+    {
+        Diff(previous, baseline, differences);
+    }
+
+    bool isSaved = Save(file, baseline);
+
+    std::lock_guard<std::mutex> lock(sessionMutex_);
+    previousState_ = std::move(previous);
+    sessionChanges_ = std::move(differences);
+    hasPreviousState_ = hasPrevious;
+    isSessionReady_ = true;
+
+    return isSaved;
+}
+
+bool CyberlibsCore::InstallState::GetSessionChanges(std::vector<Difference>& differences)
+{
+    std::lock_guard<std::mutex> lock(sessionMutex_);
+
+    if (!isSessionReady_ || !hasPreviousState_)
+    {
+        return false;
+    }
+
+    differences = sessionChanges_;
+
+    return true;
+}
+
+bool CyberlibsCore::InstallState::GetPreviousState(const std::filesystem::path& file, std::vector<Entry>& entries)
+{
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex_);
+
+        if (isSessionReady_)
+        {
+            entries = previousState_;
+
+            return hasPreviousState_;
+        }
+    }
+
+    return Load(file, entries);
+}
+
+// Private Helpers
+
+std::wstring CyberlibsCore::InstallState::makeKey(const std::string& path)
+{
+    return DirectoryScanner::FoldCase(std::filesystem::path(std::u8string(path.begin(), path.end())).generic_wstring());
+}
+
+void CyberlibsCore::InstallState::sortByKey(std::vector<Entry>& entries)
+{
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "DiagnosticsJobs.hpp"
+#include "DirectoryWalker.hpp"
+#include "FileReader.hpp"
+#include "MappedFile.hpp"
+#include "PathsParser.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Snapshot of the mod folders (path, size, write time and optionally sha256) used to answer "what changed since
+// the game last exited cleanly". States are stored as .paths manifests sorted by case-folded path, so two states
+// are compared with one merge pass and a saved state can also be checked with VerifyPaths.
+class InstallState
+{
+public:
+    static constexpr const char* DIRECTORIES[] = {"archive/pc/mod", "bin/x64/plugins", "red4ext/plugins",
+                                                  "r6/scripts", "r6/tweaks"};
+    // Files rewritten by every session (logs, CET's settings and databases) would show up as modified every time.
+    static constexpr const char* EXCLUDED[] = {"**/*.log", "**/*.sqlite3", "**/*.sqlite3-*",
+                                               "cyber_engine_tweaks/config.json",
+                                               "cyber_engine_tweaks/persistent.json"};
+    static constexpr uint64_t MAX_STATE_SIZE = 64 * 1024 * 1024;
+    // Relative to the diagnostics output folder.
+    static constexpr const char* STATE_PATH = "_STATE/installState.paths";
+
+    struct Entry
+    {
+        // UTF-8, relative to the game directory, '/' separated.
+        std::string path;
+        std::wstring key;
+        uint64_t size;
+        uint64_t lastWriteTime;
+        std::string hash;
+    };
+
+    enum class Change
+    {
+        Added,
+        Removed,
+        Modified
+    };
+
+    struct Difference
+    {
+        Change change;
+        std::string path;
+        uint64_t sizeBefore;
+        uint64_t sizeAfter;
+    };
+
+    // Walks the mod folders. Files whose size and write time match an entry of previous take its hash; with
+    // hashFiles, the remaining files are hashed in parallel and their total size becomes the job's byte total.
+    // A cancelled job stops the walk and the hashing, leaving entries incomplete.
+    static void Capture(const std::filesystem::path& gameRoot, const std::vector<Entry>* previous, bool hashFiles,
+                        uint32_t maxThreads, std::vector<Entry>& entries, DiagnosticsJob* job = nullptr);
+    static bool Save(const std::filesystem::path& file, const std::vector<Entry>& entries);
+    // The text Save writes: a .paths manifest with "path | hash | size | last write time" lines.
+    static std::string Serialize(const std::vector<Entry>& entries);
+    static bool Load(const std::filesystem::path& file, std::vector<Entry>& entries);
+    // A file counts as modified when its size changed, or its write time changed and hashes cannot prove the
+    // content is the same.
+    static void Diff(const std::vector<Entry>& before, const std::vector<Entry>& after,
+                     std::vector<Difference>& differences);
+    static const char* ToString(Change change);
+
+    // Loads the state the previous session left in file, captures the mod folders as this session's baseline and
+    // saves it at once, so a session that crashes still leaves a state for the next one to diff against.
+    static bool BeginSession(const std::filesystem::path& gameRoot, const std::filesystem::path& file,
+                             uint32_t maxThreads);
+    // Changes between the previous session's state and this session's baseline. False until BeginSession has
+    // finished, or when there was no previous state.
+    static bool GetSessionChanges(std::vector<Difference>& differences);
+    // The previous session's state; read from file while BeginSession has not finished yet.
+    static bool GetPreviousState(const std::filesystem::path& file, std::vector<Entry>& entries);
+
+private:
+    static constexpr const char* HEADER = "# Cyberlibs install state\n";
+
+    static std::wstring makeKey(const std::string& path);
+    static void sortByKey(std::vector<Entry>& entries);
+
+    static inline std::mutex sessionMutex_;
+    static inline bool isSessionReady_ = false;
+    static inline bool hasPreviousState_ = false;
+    static inline std::vector<Entry> previousState_;
+    static inline std::vector<Difference> sessionChanges_;
+};
+} // namespace CyberlibsCore
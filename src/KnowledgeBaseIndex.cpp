@@ -0,0 +1,167 @@
+#include "KnowledgeBaseIndex.hpp"
+
+void CyberlibsCore::KnowledgeBaseIndex::Add(std::string_view modName, std::string_view relativePath)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    insert(modName, relativePath, true);
+}
+
+void CyberlibsCore::KnowledgeBaseIndex::Load(const std::filesystem::path& directory)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (loaded_)
+    {
+        return;
+    }
+
+    loaded_ = true;
+
+    std::error_code ec;
+    std::filesystem::recursive_directory_iterator it(directory, ec);
+    if (ec)
+    {
+        return;
+    }
+
+    std::vector<PathsParser::Record> records;
+    for (; it != std::filesystem::recursive_directory_iterator(); it.increment(ec))
+    {
+        if (ec)
+        {
+            break;
+        }
+
+        const auto& manifestPath = it->path();
+        if (!it->is_regular_file(ec) || manifestPath.extension() != ".paths")
+        {
+            continue;
+        }
+
+        auto relative = manifestPath.lexically_relative(directory);
+        auto nameSource = relative.has_parent_path() ? *relative.begin() : relative.stem();
+        auto name = nameSource.u8string();
+
+        MappedFile manifest;
+        if (!manifest.Open(manifestPath, MAX_MANIFEST_SIZE) || !PathsParser::Parse(manifest.View(), records))
+        {
+            continue;
+        }
+
+        for (const auto& record : records)
+        {
+            if (record.shouldExist && !record.isPattern)
+            {
+                insert(std::string_view(reinterpret_cast<const char*>(name.data()), name.size()), record.path, false);
+            }
+        }
+    }
+}
+
+std::vector<std::string> CyberlibsCore::KnowledgeBaseIndex::Identify(const std::vector<std::string_view>& paths)
+{
+    std::vector<std::string> result(paths.size());
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (size_t i = 0; i < paths.size(); ++i)
+    {
+        if (const auto* name = find(normalize(paths[i])))
+        {
+            result[i] = *name;
+        }
+    }
+
+    return result;
+}
+
+// Private Helpers
+
+void CyberlibsCore::KnowledgeBaseIndex::insert(std::string_view modName, std::string_view relativePath,
+                                               bool overwrite)
+{
+    std::string key = normalize(relativePath);
+    if (key.empty() || modName.empty())
+    {
+        return;
+    }
+
+    uint32_t nameIndex = internName(modName);
+    if (overwrite)
+    {
+        entries_.insert_or_assign(std::move(key), nameIndex);
+    }
+    else
+    {
+        entries_.try_emplace(std::move(key), nameIndex);
+    }
+}
+
+uint32_t CyberlibsCore::KnowledgeBaseIndex::internName(std::string_view modName)
+{
+    auto [it, inserted] = nameIndices_.try_emplace(std::string(modName), static_cast<uint32_t>(names_.size()));
+    if (inserted)
+    {
+        names_.emplace_back(modName);
+    }
+
+    return it->second;
+}
+
+std::string CyberlibsCore::KnowledgeBaseIndex::normalize(std::string_view path)
+{
+    // Same folding as the Lua side: forward slashes, ASCII lowercase, no empty components.
+    std::string result;
+    result.reserve(path.size());
+
+    for (char c : path)
+    {
+        if (c == '\\')
+        {
+            c = '/';
+        }
+        else if (c >= 'A' && c <= 'Z')
+        {
+            c = static_cast<char>(c - 'A' + 'a');
+        }
+
+        if (c == '/' && (result.empty() || result.back() == '/'))
+        {
+            continue;
+        }
+
+        result.push_back(c);
+    }
+
+    while (!result.empty() && result.back() == '/')
+    {
+        result.pop_back();
+    }
+
+    return result;
+}
+
+const std::string* CyberlibsCore::KnowledgeBaseIndex::find(const std::string& normalizedPath)
+{
+    // Try the whole path, then every suffix that starts at a component boundary, so absolute paths and paths with
+    // a drive letter still resolve.
+    std::string_view key = normalizedPath;
+    while (!key.empty())
+    {
+        auto it = entries_.find(key);
+        if (it != entries_.end())
+        {
+            return &names_[it->second];
+        }
+
+        size_t slashPos = key.find('/');
+        if (slashPos == std::string_view::npos)
+        {
+            break;
+        }
+
+        key.remove_prefix(slashPos + 1);
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "MappedFile.hpp"
+#include "PathsParser.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Reverse lookup from a game file to the known mod that ships it. The knowledge-base .paths manifests are compiled
+// once into a hash map keyed by lowercase relative path, so identifying a file costs one probe per path component
+// instead of a scan over every known mod.
+class KnowledgeBaseIndex
+{
+public:
+    static constexpr uint64_t MAX_MANIFEST_SIZE = 5 * 1024 * 1024;
+
+    // Registers a mod's marker file. Markers win over manifest entries, since shared files such as loaders appear in
+    // more than one manifest.
+    static void Add(std::string_view modName, std::string_view relativePath);
+    // Compiles every .paths manifest under directory. A manifest in a subfolder belongs to the mod named after the
+    // subfolder, otherwise to the mod named after the file. Only the first call does any work.
+    static void Load(const std::filesystem::path& directory);
+    // Returns the mod name for each path, or an empty string when no mod is known. Paths may be relative to the game
+    // directory or carry any prefix in front of it; matching happens on whole path components.
+    static std::vector<std::string> Identify(const std::vector<std::string_view>& paths);
+
+private:
+    struct KeyHash
+    {
+        using is_transparent = void;
+
+        size_t operator()(std::string_view key) const
+        {
+            return std::hash<std::string_view>()(key);
+        }
+    };
+
+    using Entries = std::unordered_map<std::string, uint32_t, KeyHash, std::equal_to<>>;
+
+    static void insert(std::string_view modName, std::string_view relativePath, bool overwrite);
+    static uint32_t internName(std::string_view modName);
+    static std::string normalize(std::string_view path);
+    static const std::string* find(const std::string& normalizedPath);
+
+    static inline std::mutex mutex_;
+    static inline Entries entries_;
+    static inline std::vector<std::string> names_;
+    static inline std::unordered_map<std::string, uint32_t> nameIndices_;
+    static inline bool loaded_ = false;
+};
+} // namespace CyberlibsCore
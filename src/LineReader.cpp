@@ -0,0 +1,165 @@
+#include "LineReader.hpp"
+#include "DirectoryScanner.hpp"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <bit>
+
+bool CyberlibsCore::LineReader::Open(const std::filesystem::path& path)
+{
+    index_.reset();
+
+    if (!file_.Open(path, UINT64_MAX))
+    {
+        return false;
+    }
+
+    index_ = acquire(path, file_.LastWriteTime(), file_.View());
+    text_ = file_.View();
+    if (index_->isTranscoded)
+    {
+        // The index owns the UTF-8 text, so the mapping is no longer needed.
+        file_.Close();
+        text_ = index_->transcoded;
+    }
+
+    return true;
+}
+
+size_t CyberlibsCore::LineReader::LineCount() const
+{
+    if (!index_)
+    {
+        return 0;
+    }
+
+    // A terminated last line leaves a start at the very end of the file, which is not a line of its own.
+    return index_->starts.back() == text_.size() ? index_->starts.size() - 1 : index_->starts.size();
+}
+
+std::string_view CyberlibsCore::LineReader::Line(size_t index) const
+{
+    std::string_view view = text_;
+    size_t begin = static_cast<size_t>(index_->starts[index]);
+    size_t end = index + 1 < index_->starts.size() ? static_cast<size_t>(index_->starts[index + 1]) - 1 : view.size();
+    if (end > begin && view[end - 1] == '\r')
+    {
+        --end;
+    }
+
+    return view.substr(begin, end - begin);
+}
+
+size_t CyberlibsCore::LineReader::LineAt(size_t offset) const
+{
+    const auto& starts = index_->starts;
+
+    return static_cast<size_t>(std::upper_bound(starts.begin(), starts.end(), offset) - starts.begin()) - 1;
+}
+
+size_t CyberlibsCore::LineReader::NextLineStart(size_t offset) const
+{
+    size_t line = LineAt(offset);
+
+    return line + 1 < index_->starts.size() ? static_cast<size_t>(index_->starts[line + 1]) : text_.size();
+}
+
+// Private Helpers
+
+std::shared_ptr<const CyberlibsCore::LineReader::Index> CyberlibsCore::LineReader::acquire(
+    const std::filesystem::path& path, uint64_t lastWriteTime, std::string_view view)
+{
+    std::wstring key = DirectoryScanner::FoldCase(path.wstring());
+    std::string_view head = view.substr(0, HEAD_SIZE);
+
+    std::lock_guard<std::mutex> lock(cacheMutex_);
+
+    std::shared_ptr<const Index> cached;
+    for (auto it = cache_.begin(); it != cache_.end(); ++it)
+    {
+        if ((*it)->key == key)
+        {
+            cached = *it;
+            cache_.erase(it);
+            break;
+        }
+    }
+
+    if (cached && cached->size == view.size() && cached->lastWriteTime == lastWriteTime && cached->head == head)
+    {
+        cache_.push_front(cached);
+        return cached;
+    }
+
+    auto index = std::make_shared<Index>();
+    index->key = std::move(key);
+    index->head = std::string(head);
+    index->size = view.size();
+    index->lastWriteTime = lastWriteTime;
+
+    // Transcoded once per version of the file; every Open until it changes reuses the text kept here.
+    std::string_view text = view;
+    if (TextEncoding::IsUtf16Le(view))
+    {
+        TextEncoding::Utf16LeToUtf8(view, index->transcoded);
+        index->isTranscoded = true;
+        text = index->transcoded;
+    }
+
+    // Logs only ever grow, so a file that still starts the same way keeps every line start found so far. UTF-16LE
+    // files are indexed from scratch, since their byte offsets do not carry over to the transcoded text.
+    size_t begin = 0;
+    if (!index->isTranscoded && cached && !cached->isTranscoded && cached->size < view.size() &&
+        cached->head.size() <= head.size() && head.substr(0, cached->head.size()) == cached->head)
+    {
+        index->starts = cached->starts;
+        begin = static_cast<size_t>(cached->size);
+    }
+    else
+    {
+        index->starts.push_back(0);
+    }
+
+    indexLines(text.data(), begin, text.size(), index->starts);
+
+    cache_.push_front(index);
+    if (cache_.size() > CACHE_SIZE)
+    {
+        cache_.pop_back();
+    }
+
+    return index;
+}
+
+void CyberlibsCore::LineReader::indexLines(const char* data, size_t begin, size_t end, std::vector<uint64_t>& starts)
+{
+    const __m128i newline = _mm_set1_epi8('\n');
+    size_t i = begin;
+
+    // 64 bytes per step: four compares folded into one mask, so long lines cost a single test per block.
+    for (; i + 64 <= end; i += 64)
+    {
+        uint64_t mask = 0;
+        for (size_t lane = 0; lane < 4; ++lane)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + lane * 16));
+            uint64_t bits = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, newline)));
+            mask |= bits << (lane * 16);
+        }
+
+        while (mask != 0)
+        {
+            starts.push_back(i + std::countr_zero(mask) + 1);
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i < end; ++i)
+    {
+        if (data[i] == '\n')
+        {
+            starts.push_back(i + 1);
+        }
+    }
+}
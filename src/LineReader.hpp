@@ -0,0 +1,79 @@
+#pragma once
+
+#include "MappedFile.hpp"
+#include "TextEncoding.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Random access to the lines of a text file of any size. The file is mapped rather than read, and the offset of every
+// line is found with a SIMD newline scan. Indexes of recently read files are kept, so paging through a log costs one
+// mapping per call, and a log that only grew since the last call is indexed from where the previous scan stopped.
+// UTF-16LE files are transcoded to UTF-8 and the result is kept with their index, so lines and offsets always refer
+// to UTF-8 text and an unchanged file is only transcoded once.
+class LineReader
+{
+public:
+    LineReader() = default;
+
+    LineReader(const LineReader&) = delete;
+    LineReader& operator=(const LineReader&) = delete;
+
+    // Maps the file and brings its index up to date. Returns false if the file cannot be opened.
+    bool Open(const std::filesystem::path& path);
+
+    size_t LineCount() const;
+    // Returns the line without its "\n" or "\r\n" terminator. index must be below LineCount().
+    std::string_view Line(size_t index) const;
+    // Index of the line holding the byte at offset, which must lie inside Text().
+    size_t LineAt(size_t offset) const;
+    // Start of the line after the one holding offset, or the end of the text for the last line.
+    size_t NextLineStart(size_t offset) const;
+
+    std::string_view Text() const
+    {
+        return text_;
+    }
+
+private:
+    static constexpr size_t CACHE_SIZE = 4;
+    // Enough of the start of the file to tell an appended log from a rewritten one.
+    static constexpr size_t HEAD_SIZE = 64;
+
+    struct Index
+    {
+        std::wstring key;
+        // head, size and lastWriteTime describe the file on disk, before any transcoding.
+        std::string head;
+        uint64_t size;
+        // A rewrite that keeps the size and the first bytes still moves the write time.
+        uint64_t lastWriteTime;
+        bool isTranscoded = false;
+        // UTF-8 text of a UTF-16LE file; empty otherwise.
+        std::string transcoded;
+        // Offset of each line start in the UTF-8 text; the first line always starts at 0.
+        std::vector<uint64_t> starts;
+    };
+
+    static std::shared_ptr<const Index> acquire(const std::filesystem::path& path, uint64_t lastWriteTime,
+                                                std::string_view view);
+    static void indexLines(const char* data, size_t begin, size_t end, std::vector<uint64_t>& starts);
+
+    // Released right after Open for UTF-16LE files, whose text lives in the index.
+    MappedFile file_;
+    std::string_view text_;
+    std::shared_ptr<const Index> index_;
+
+    static inline std::mutex cacheMutex_;
+    // Most recently used first.
+    static inline std::list<std::shared_ptr<const Index>> cache_;
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,280 @@
+#include "LineSearch.hpp"
+
+#include <emmintrin.h>
+
+#include <bit>
+#include <cstring>
+
+bool CyberlibsCore::LineSearch::Compile(std::string_view needle, const Options& options)
+{
+    regex_.reset();
+    ignoreCase_ = options.ignoreCase;
+
+    // Lines are matched one at a time, so a needle spanning a line break could never match.
+    if (needle.empty() || needle.find('\n') != std::string_view::npos)
+    {
+        return false;
+    }
+
+    if (options.regex)
+    {
+        auto flags = std::regex::ECMAScript | std::regex::optimize;
+        if (options.ignoreCase)
+        {
+            flags |= std::regex::icase;
+        }
+
+        try
+        {
+            regex_.emplace(needle.begin(), needle.end(), flags);
+        }
+        catch (const std::regex_error&)
+        {
+            return false;
+        }
+
+        literal_ = requiredLiteral(needle);
+    }
+    else
+    {
+        literal_ = std::string(needle);
+    }
+
+    if (ignoreCase_)
+    {
+        for (char& c : literal_)
+        {
+            c = foldCase(c);
+        }
+    }
+
+    return true;
+}
+
+void CyberlibsCore::LineSearch::Search(const LineReader& reader, size_t maxMatches, std::vector<size_t>& lines) const
+{
+    auto matchesLine = [this](std::string_view line) { return !regex_ || matchesRegex(line); };
+
+    size_t found = 0;
+    if (literal_.empty())
+    {
+        for (size_t i = 0; i < reader.LineCount() && found < maxMatches; ++i)
+        {
+            if (matchesLine(reader.Line(i)))
+            {
+                lines.push_back(i);
+                ++found;
+            }
+        }
+
+        return;
+    }
+
+    std::string_view text = reader.Text();
+    size_t position = 0;
+    while (found < maxMatches)
+    {
+        size_t hit = find(text, position);
+        if (hit == std::string_view::npos)
+        {
+            break;
+        }
+
+        size_t line = reader.LineAt(hit);
+        if (matchesLine(reader.Line(line)))
+        {
+            lines.push_back(line);
+            ++found;
+        }
+
+        // One hit per line is enough; resume at the next line.
+        position = reader.NextLineStart(hit);
+    }
+}
+
+// Private Helpers
+
+size_t CyberlibsCore::LineSearch::find(std::string_view text, size_t position) const
+{
+    const char* data = text.data();
+    size_t size = text.size();
+    size_t length = literal_.size();
+    if (length > size)
+    {
+        return std::string_view::npos;
+    }
+
+    // Compare the first and the last byte of the needle at sixteen positions at once and only verify the positions
+    // where both agree. Case-insensitive search tests both cases of each byte.
+    char first = literal_.front();
+    char last = literal_.back();
+    auto upper = [this](char c) { return ignoreCase_ && c >= 'a' && c <= 'z' ? static_cast<char>(c - 32) : c; };
+    const __m128i firstLower = _mm_set1_epi8(first);
+    const __m128i firstUpper = _mm_set1_epi8(upper(first));
+    const __m128i lastLower = _mm_set1_epi8(last);
+    const __m128i lastUpper = _mm_set1_epi8(upper(last));
+
+    size_t i = position;
+    for (; i + length - 1 + 16 <= size; i += 16)
+    {
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + length - 1));
+        __m128i headHits = _mm_or_si128(_mm_cmpeq_epi8(head, firstLower), _mm_cmpeq_epi8(head, firstUpper));
+        __m128i tailHits = _mm_or_si128(_mm_cmpeq_epi8(tail, lastLower), _mm_cmpeq_epi8(tail, lastUpper));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_and_si128(headHits, tailHits)));
+
+        while (mask != 0)
+        {
+            size_t candidate = i + std::countr_zero(mask);
+            if (equalsAt(data + candidate))
+            {
+                return candidate;
+            }
+
+            mask &= mask - 1;
+        }
+    }
+
+    for (; i + length <= size; ++i)
+    {
+        if (equalsAt(data + i))
+        {
+            return i;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+bool CyberlibsCore::LineSearch::matchesRegex(std::string_view line) const
+{
+    auto flags = std::regex_constants::match_default;
+    if (line.size() > MAX_REGEX_LINE_LENGTH)
+    {
+        line = line.substr(0, MAX_REGEX_LINE_LENGTH);
+        flags |= std::regex_constants::match_not_eol;
+    }
+
+    try
+    {
+        return std::regex_search(line.data(), line.data() + line.size(), *regex_, flags);
+    }
+    catch (const std::regex_error&)
+    {
+        // error_complexity or error_stack: too expensive to decide, so not reported as a match.
+        return false;
+    }
+}
+
+bool CyberlibsCore::LineSearch::equalsAt(const char* data) const
+{
+    if (!ignoreCase_)
+    {
+        return std::memcmp(data, literal_.data(), literal_.size()) == 0;
+    }
+
+    for (size_t i = 0; i < literal_.size(); ++i)
+    {
+        if (foldCase(data[i]) != literal_[i])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::string CyberlibsCore::LineSearch::requiredLiteral(std::string_view pattern)
+{
+    if (pattern.find('|') != std::string_view::npos)
+    {
+        return std::string();
+    }
+
+    std::string best;
+    std::string current;
+    int depth = 0;
+    auto endRun = [&best, &current]()
+    {
+        if (current.size() > best.size())
+        {
+            best = current;
+        }
+
+        current.clear();
+    };
+
+    for (size_t i = 0; i < pattern.size(); ++i)
+    {
+        char c = pattern[i];
+        switch (c)
+        {
+        case '\\':
+            // Escapes may be classes (\d, \b) rather than characters; treat them all as a break.
+            endRun();
+            ++i;
+            break;
+        case '[':
+            // A leading ']' (after an optional '^') is a member of the set, not its end.
+            endRun();
+            i += pattern.substr(i + 1, 1) == "^" ? 2 : 1;
+            i += pattern.substr(i, 1) == "]" ? 1 : 0;
+            while (i < pattern.size() && pattern[i] != ']')
+            {
+                i += pattern[i] == '\\' ? 2 : 1;
+            }
+            break;
+        case '(':
+            ++depth;
+            endRun();
+            break;
+        case ')':
+            --depth;
+            endRun();
+            break;
+        case '?':
+        case '*':
+        case '{':
+            // The quantified character is optional, so it cannot be part of a required run.
+            if (!current.empty())
+            {
+                current.pop_back();
+            }
+            endRun();
+            if (c == '{')
+            {
+                i = pattern.find('}', i);
+                if (i == std::string_view::npos)
+                {
+                    return best;
+                }
+            }
+            break;
+        case '+':
+        case '.':
+        case '^':
+        case '$':
+            endRun();
+            break;
+        default:
+            if (depth == 0)
+            {
+                current += c;
+            }
+            else
+            {
+                endRun();
+            }
+            break;
+        }
+    }
+
+    endRun();
+
+    return best;
+}
+
+char CyberlibsCore::LineSearch::foldCase(char c)
+{
+    return c >= 'A' && c <= 'Z' ? static_cast<char>(c + 32) : c;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "LineReader.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Finds the lines of a text that match a literal or a regular expression. A SIMD scan looks for the needle (or, for a
+// regex, a literal every match must contain) across the whole text, and only the lines it lands on are run through
+// the regex. Every byte is still read at least once: by the scan, and by LineReader's newline index. A regex
+// without a required literal is run on every line.
+class LineSearch
+{
+public:
+    struct Options
+    {
+        bool ignoreCase = false;
+        // ECMAScript syntax, matched against each line on its own.
+        bool regex = false;
+    };
+
+    // std::regex matches recursively and can exhaust the stack on long lines, so a regex only sees this many bytes
+    // of each line. "$" does not match at the cut.
+    static constexpr size_t MAX_REGEX_LINE_LENGTH = 2048;
+
+    // Returns false for an empty needle or a pattern std::regex rejects.
+    bool Compile(std::string_view needle, const Options& options);
+    // Appends the indices of matching lines in ascending order, at most maxMatches of them.
+    void Search(const LineReader& reader, size_t maxMatches, std::vector<size_t>& lines) const;
+
+private:
+    // Offset of the first occurrence of literal_ at or after position, or npos.
+    size_t find(std::string_view text, size_t position) const;
+    bool matchesRegex(std::string_view line) const;
+    bool equalsAt(const char* data) const;
+
+    // The longest run of plain characters every match of pattern has to contain, or empty when there is no such run
+    // (alternations, groups and quantified characters all make text optional).
+    static std::string requiredLiteral(std::string_view pattern);
+    static char foldCase(char c);
+
+    std::string literal_;
+    bool ignoreCase_ = false;
+    std::optional<std::regex> regex_;
+};
+} // namespace CyberlibsCore
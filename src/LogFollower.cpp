@@ -0,0 +1,194 @@
+#include "LogFollower.hpp"
+
+#include <algorithm>
+
+uint64_t CyberlibsCore::LogFollower::Open(const std::filesystem::path& path, bool fromStart)
+{
+    HANDLE file = openShared(path);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return 0;
+    }
+
+    Cursor cursor{path, 0, 0, 0, 0, std::string()};
+    uint64_t size = 0;
+    bool isValid = queryIdentity(file, cursor.volume, cursor.fileId, cursor.creationTime, size);
+    if (isValid)
+    {
+        readHead(file, size, cursor.head);
+    }
+
+    CloseHandle(file);
+    if (!isValid)
+    {
+        return 0;
+    }
+
+    cursor.offset = fromStart ? 0 : size;
+
+    uint64_t handle = nextHandle_.fetch_add(1);
+    std::lock_guard<std::mutex> lock(cursorsMutex_);
+    cursors_.emplace(handle, std::move(cursor));
+
+    return handle;
+}
+
+CyberlibsCore::LogFollower::Status CyberlibsCore::LogFollower::ReadNew(uint64_t handle, std::string& text)
+{
+    Cursor cursor;
+    {
+        std::lock_guard<std::mutex> lock(cursorsMutex_);
+        auto it = cursors_.find(handle);
+        if (it == cursors_.end())
+        {
+            return Status::InvalidHandle;
+        }
+
+        cursor = it->second;
+    }
+
+    // Reopened on every call: a handle kept open would keep following the old file after a rotation.
+    HANDLE file = openShared(cursor.path);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return Status::Missing;
+    }
+
+    uint64_t volume = 0;
+    uint64_t fileId = 0;
+    uint64_t creationTime = 0;
+    uint64_t size = 0;
+    if (!queryIdentity(file, volume, fileId, creationTime, size))
+    {
+        CloseHandle(file);
+        return Status::Missing;
+    }
+
+    // A log truncated and written again can already be longer than the offset, so the size alone cannot tell.
+    std::string head;
+    readHead(file, size, head);
+
+    Status status = Status::Ok;
+    if (volume != cursor.volume || fileId != cursor.fileId || creationTime != cursor.creationTime)
+    {
+        status = Status::Rotated;
+        cursor.volume = volume;
+        cursor.fileId = fileId;
+        cursor.creationTime = creationTime;
+        cursor.offset = 0;
+    }
+    else if (size < cursor.offset || head.compare(0, cursor.head.size(), cursor.head) != 0)
+    {
+        status = Status::Truncated;
+        cursor.offset = 0;
+    }
+
+    cursor.head = std::move(head);
+
+    DWORD toRead = static_cast<DWORD>((std::min<uint64_t>)(size - cursor.offset, MAX_READ_SIZE));
+    if (toRead != 0)
+    {
+        std::string buffer(toRead, '\0');
+        OVERLAPPED overlapped{};
+        overlapped.Offset = static_cast<DWORD>(cursor.offset);
+        overlapped.OffsetHigh = static_cast<DWORD>(cursor.offset >> 32);
+
+        DWORD bytesRead = 0;
+        if (ReadFile(file, buffer.data(), toRead, &bytesRead, &overlapped))
+        {
+            buffer.resize(bytesRead);
+
+            size_t lineEnd = buffer.rfind('\n');
+            size_t length = lineEnd != std::string::npos ? lineEnd + 1 : (bytesRead == MAX_READ_SIZE ? bytesRead : 0);
+            text.append(buffer, 0, length);
+            cursor.offset += length;
+        }
+    }
+
+    CloseHandle(file);
+
+    std::lock_guard<std::mutex> lock(cursorsMutex_);
+    auto it = cursors_.find(handle);
+    if (it != cursors_.end())
+    {
+        it->second = std::move(cursor);
+    }
+
+    return status;
+}
+
+bool CyberlibsCore::LogFollower::Close(uint64_t handle)
+{
+    std::lock_guard<std::mutex> lock(cursorsMutex_);
+
+    return cursors_.erase(handle) != 0;
+}
+
+void CyberlibsCore::LogFollower::CloseAll()
+{
+    std::lock_guard<std::mutex> lock(cursorsMutex_);
+    cursors_.clear();
+}
+
+const char* CyberlibsCore::LogFollower::ToString(Status status)
+{
+    switch (status)
+    {
+    case Status::Ok:
+        return "ok";
+    case Status::Truncated:
+        return "truncated";
+    case Status::Rotated:
+        return "rotated";
+    case Status::Missing:
+        return "missing";
+    case Status::InvalidHandle:
+        return "invalidHandle";
+    }
+
+    return "unknown";
+}
+
+// Private Helpers
+
+HANDLE CyberlibsCore::LogFollower::openShared(const std::filesystem::path& path)
+{
+    return CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                       OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+}
+
+bool CyberlibsCore::LogFollower::queryIdentity(HANDLE file, uint64_t& volume, uint64_t& fileId,
+                                               uint64_t& creationTime, uint64_t& size)
+{
+    BY_HANDLE_FILE_INFORMATION info;
+    if (!GetFileInformationByHandle(file, &info))
+    {
+        return false;
+    }
+
+    volume = info.dwVolumeSerialNumber;
+    fileId = (static_cast<uint64_t>(info.nFileIndexHigh) << 32) | info.nFileIndexLow;
+    creationTime =
+        (static_cast<uint64_t>(info.ftCreationTime.dwHighDateTime) << 32) | info.ftCreationTime.dwLowDateTime;
+    size = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+
+    return true;
+}
+
+void CyberlibsCore::LogFollower::readHead(HANDLE file, uint64_t size, std::string& head)
+{
+    head.assign(static_cast<size_t>((std::min<uint64_t>)(size, HEAD_SIZE)), '\0');
+    if (head.empty())
+    {
+        return;
+    }
+
+    OVERLAPPED overlapped{};
+    DWORD bytesRead = 0;
+    if (!ReadFile(file, head.data(), static_cast<DWORD>(head.size()), &bytesRead, &overlapped))
+    {
+        bytesRead = 0;
+    }
+
+    head.resize(bytesRead);
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace CyberlibsCore
+{
+// Live tail of log files. Each handle keeps a cursor made of the file's identity and a byte offset, so every read
+// costs only the bytes appended since the previous one. A file with a new identity (volume, file id or creation
+// time) was replaced (rotated). A file that shrank, or whose first bytes changed, was truncated, even if it has
+// since grown past the old offset again. In both cases the cursor starts over from the beginning of the new content.
+class LogFollower
+{
+public:
+    enum class Status
+    {
+        Ok,
+        Truncated,
+        Rotated,
+        Missing,
+        InvalidHandle
+    };
+
+    // Upper bound for one read; the rest is returned by the following calls.
+    static constexpr uint32_t MAX_READ_SIZE = 4 * 1024 * 1024;
+    // Bytes at the start of the file remembered to tell an appended log from a rewritten one.
+    static constexpr uint32_t HEAD_SIZE = 64;
+
+    // Returns 0 if the file cannot be opened. fromStart also delivers the content already in the file.
+    static uint64_t Open(const std::filesystem::path& path, bool fromStart);
+    // Appends only whole lines to text, so a line that is still being written waits for its newline (unless it alone
+    // fills MAX_READ_SIZE).
+    static Status ReadNew(uint64_t handle, std::string& text);
+    static bool Close(uint64_t handle);
+    static void CloseAll();
+    static const char* ToString(Status status);
+
+private:
+    struct Cursor
+    {
+        std::filesystem::path path;
+        uint64_t volume;
+        uint64_t fileId;
+        uint64_t creationTime;
+        uint64_t offset;
+        std::string head;
+    };
+
+    // Opens path for reading without blocking the writer, or renaming and deleting by log rotation.
+    static HANDLE openShared(const std::filesystem::path& path);
+    static bool queryIdentity(HANDLE file, uint64_t& volume, uint64_t& fileId, uint64_t& creationTime,
+                              uint64_t& size);
+    // Reads up to HEAD_SIZE bytes from the start of the file.
+    static void readHead(HANDLE file, uint64_t size, std::string& head);
+
+    static inline std::mutex cursorsMutex_;
+    static inline std::unordered_map<uint64_t, Cursor> cursors_;
+    static inline std::atomic<uint64_t> nextHandle_{1};
+};
+} // namespace CyberlibsCore
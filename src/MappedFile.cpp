@@ -0,0 +1,147 @@
+#include "MappedFile.hpp"
+
+CyberlibsCore::MappedFile::~MappedFile()
+{
+    Close();
+}
+
+bool CyberlibsCore::MappedFile::Open(const std::filesystem::path& path, uint64_t maxSize)
+{
+    if (!openFile(path, FILE_FLAG_SEQUENTIAL_SCAN, maxSize))
+    {
+        return false;
+    }
+
+    // Zero-length files cannot be mapped, but they are still valid (empty) input.
+    if (fileSize_ == 0)
+    {
+        return true;
+    }
+
+    base_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+    if (!base_)
+    {
+        Close();
+        return false;
+    }
+
+    view_ = base_;
+    size_ = static_cast<size_t>(fileSize_);
+
+    return true;
+}
+
+bool CyberlibsCore::MappedFile::OpenForRanges(const std::filesystem::path& path)
+{
+    return openFile(path, FILE_FLAG_RANDOM_ACCESS, UINT64_MAX);
+}
+
+std::string_view CyberlibsCore::MappedFile::MapRange(uint64_t offset, size_t size)
+{
+    unmap();
+
+    if (!mapping_ || size == 0 || offset > fileSize_ || size > fileSize_ - offset)
+    {
+        return std::string_view();
+    }
+
+    // Views have to start on an allocation granularity boundary; the bytes before offset are mapped but not exposed.
+    uint64_t start = offset - offset % allocationGranularity();
+    base_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, static_cast<DWORD>(start >> 32),
+                                                   static_cast<DWORD>(start),
+                                                   static_cast<SIZE_T>(offset - start) + size));
+    if (!base_)
+    {
+        return std::string_view();
+    }
+
+    view_ = base_ + (offset - start);
+    size_ = size;
+
+    return View();
+}
+
+void CyberlibsCore::MappedFile::Close()
+{
+    unmap();
+
+    if (mapping_)
+    {
+        CloseHandle(mapping_);
+        mapping_ = NULL;
+    }
+
+    if (file_ != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+    }
+
+    fileSize_ = 0;
+    lastWriteTime_ = 0;
+}
+
+// Private Helpers
+
+bool CyberlibsCore::MappedFile::openFile(const std::filesystem::path& path, DWORD flags, uint64_t maxSize)
+{
+    Close();
+
+    file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | flags, NULL);
+    if (file_ == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    FILETIME lastWriteTime;
+    if (!GetFileSizeEx(file_, &fileSize) || static_cast<uint64_t>(fileSize.QuadPart) > maxSize ||
+        !GetFileTime(file_, NULL, NULL, &lastWriteTime))
+    {
+        Close();
+        return false;
+    }
+
+    fileSize_ = static_cast<uint64_t>(fileSize.QuadPart);
+    lastWriteTime_ = (static_cast<uint64_t>(lastWriteTime.dwHighDateTime) << 32) | lastWriteTime.dwLowDateTime;
+
+    if (fileSize_ == 0)
+    {
+        return true;
+    }
+
+    mapping_ = CreateFileMappingW(file_, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (!mapping_)
+    {
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void CyberlibsCore::MappedFile::unmap()
+{
+    if (base_)
+    {
+        UnmapViewOfFile(base_);
+        base_ = nullptr;
+    }
+
+    view_ = nullptr;
+    size_ = 0;
+}
+
+DWORD CyberlibsCore::MappedFile::allocationGranularity()
+{
+    static const DWORD granularity = []()
+    {
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+
+        return info.dwAllocationGranularity;
+    }();
+
+    return granularity;
+}
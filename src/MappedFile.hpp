@@ -0,0 +1,63 @@
+#pragma once
+
+#include <windows.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+namespace CyberlibsCore
+{
+// Read-only view of a whole file. Parsers work on the mapping directly instead of copying it into a string first.
+// Readers that only need a few small pieces of a large file map them one range at a time instead.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Fails for missing files and files larger than maxSize. An empty file maps to an empty view.
+    bool Open(const std::filesystem::path& path, uint64_t maxSize);
+    // Opens the file for MapRange without mapping any of it. Reads are hinted as random, so the system does not read
+    // ahead into the parts that are never looked at.
+    bool OpenForRanges(const std::filesystem::path& path);
+    // Maps size bytes at offset in place of the previous view and returns them. Empty if the range does not lie
+    // inside the file or cannot be mapped.
+    std::string_view MapRange(uint64_t offset, size_t size);
+    void Close();
+
+    std::string_view View() const
+    {
+        return std::string_view(view_, size_);
+    }
+
+    // Size of the file on disk, whatever part of it is mapped.
+    uint64_t Size() const
+    {
+        return fileSize_;
+    }
+
+    // FILETIME of the last write, read when the file was opened.
+    uint64_t LastWriteTime() const
+    {
+        return lastWriteTime_;
+    }
+
+private:
+    bool openFile(const std::filesystem::path& path, DWORD flags, uint64_t maxSize);
+    void unmap();
+    static DWORD allocationGranularity();
+
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    HANDLE mapping_ = NULL;
+    // Start of the mapped view. A range view starts on an allocation granularity boundary, so view_ may lie past it.
+    const char* base_ = nullptr;
+    const char* view_ = nullptr;
+    size_t size_ = 0;
+    uint64_t fileSize_ = 0;
+    uint64_t lastWriteTime_ = 0;
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,113 @@
+#include "NotificationDirectoryWatcher.hpp"
+
+CyberlibsCore::NotificationDirectoryWatcher::~NotificationDirectoryWatcher()
+{
+    Stop();
+}
+
+bool CyberlibsCore::NotificationDirectoryWatcher::Start(const std::filesystem::path& root)
+{
+    Stop();
+
+    root_ = root;
+    directory_ = CreateFileW(root.c_str(), FILE_LIST_DIRECTORY, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                             NULL, OPEN_EXISTING, FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, NULL);
+    if (directory_ == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    overlapped_ = {};
+    overlapped_.hEvent = CreateEventW(NULL, TRUE, FALSE, NULL);
+    buffer_.assign(BUFFER_SIZE / sizeof(DWORD), 0);
+    if (!overlapped_.hEvent || !issue())
+    {
+        Stop();
+        return false;
+    }
+
+    return true;
+}
+
+void CyberlibsCore::NotificationDirectoryWatcher::Stop()
+{
+    if (directory_ != INVALID_HANDLE_VALUE)
+    {
+        CancelIoEx(directory_, &overlapped_);
+        DWORD bytes = 0;
+        GetOverlappedResult(directory_, &overlapped_, &bytes, TRUE);
+        CloseHandle(directory_);
+        directory_ = INVALID_HANDLE_VALUE;
+    }
+
+    if (overlapped_.hEvent)
+    {
+        CloseHandle(overlapped_.hEvent);
+        overlapped_.hEvent = NULL;
+    }
+}
+
+bool CyberlibsCore::NotificationDirectoryWatcher::Poll(std::vector<std::filesystem::path>& changedDirectories)
+{
+    if (directory_ == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    DWORD bytes = 0;
+    while (GetOverlappedResult(directory_, &overlapped_, &bytes, FALSE))
+    {
+        // Zero bytes means the system buffer overflowed and the individual changes are gone.
+        bool complete = bytes != 0;
+        const auto* data = reinterpret_cast<const BYTE*>(buffer_.data());
+        while (complete)
+        {
+            const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(data);
+            std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+            std::filesystem::path changed = root_ / name;
+
+            // Files appearing or going away still count, only their constant rewrites are ignored.
+            if (info->Action == FILE_ACTION_MODIFIED && IsVolatile(changed.filename().wstring()))
+            {
+                if (info->NextEntryOffset == 0)
+                {
+                    break;
+                }
+
+                data += info->NextEntryOffset;
+                continue;
+            }
+
+            // The parent's listing holds the entry itself; the entry's own listing is stale too if it was a
+            // directory that got renamed or removed.
+            changedDirectories.push_back(changed.parent_path());
+            if (info->Action != FILE_ACTION_MODIFIED)
+            {
+                changedDirectories.push_back(std::move(changed));
+            }
+
+            if (info->NextEntryOffset == 0)
+            {
+                break;
+            }
+
+            data += info->NextEntryOffset;
+        }
+
+        ResetEvent(overlapped_.hEvent);
+        if (!issue() || !complete)
+        {
+            return false;
+        }
+    }
+
+    return GetLastError() == ERROR_IO_INCOMPLETE;
+}
+
+// Private Helpers
+
+bool CyberlibsCore::NotificationDirectoryWatcher::issue()
+{
+    return ReadDirectoryChangesW(directory_, buffer_.data(), static_cast<DWORD>(buffer_.size() * sizeof(DWORD)),
+                                 TRUE, NOTIFY_FILTER, NULL, &overlapped_, NULL) != 0;
+}
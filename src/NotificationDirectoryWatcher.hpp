@@ -0,0 +1,43 @@
+#pragma once
+
+#include <windows.h>
+#include "DirectoryWatcher.hpp"
+
+#include <filesystem>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Recursive ReadDirectoryChangesW on one subtree. Polling only checks an overlapped request, so it is cheap enough
+// to run before every cache lookup. Edits to volatile files (see DirectoryWatcher::IsVolatile) are dropped here, so
+// a mod that logs every frame does not keep invalidating its folder.
+class NotificationDirectoryWatcher : public DirectoryWatcher
+{
+public:
+    ~NotificationDirectoryWatcher() override;
+
+    bool Start(const std::filesystem::path& root) override;
+    void Stop() override;
+
+    bool ReportsFileEdits() const override
+    {
+        return true;
+    }
+
+    void Track(const std::filesystem::path&, uint64_t) override {}
+    bool Poll(std::vector<std::filesystem::path>& changedDirectories) override;
+
+private:
+    static constexpr DWORD BUFFER_SIZE = 64 * 1024;
+    static constexpr DWORD NOTIFY_FILTER = FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_DIR_NAME |
+                                           FILE_NOTIFY_CHANGE_SIZE | FILE_NOTIFY_CHANGE_LAST_WRITE;
+
+    bool issue();
+
+    std::filesystem::path root_;
+    HANDLE directory_ = INVALID_HANDLE_VALUE;
+    OVERLAPPED overlapped_{};
+    // DWORD storage keeps FILE_NOTIFY_INFORMATION records aligned.
+    std::vector<DWORD> buffer_;
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,344 @@
+#include "OutputSink.hpp"
+#include "DirectoryScanner.hpp"
+
+#include <algorithm>
+#include <vector>
+
+bool CyberlibsCore::OutputSink::Append(const std::filesystem::path& path, std::string content)
+{
+    if (content.empty())
+    {
+        return !closed_.load();
+    }
+
+    if (!beginPush())
+    {
+        return false;
+    }
+
+    ensureStarted();
+    push(new Node{nullptr, path, std::move(content), false, nullptr});
+    endPush();
+
+    return true;
+}
+
+bool CyberlibsCore::OutputSink::Replace(const std::filesystem::path& path, std::string content)
+{
+    if (!beginPush())
+    {
+        return false;
+    }
+
+    ensureStarted();
+    push(new Node{nullptr, path, std::move(content), true, nullptr});
+    endPush();
+
+    return true;
+}
+
+bool CyberlibsCore::OutputSink::Flush()
+{
+    if (!running_.load(std::memory_order_acquire))
+    {
+        return true;
+    }
+
+    if (!beginPush())
+    {
+        return false;
+    }
+
+    // The marker lands behind everything this thread queued, and batches are written in order.
+    Marker marker;
+    push(new Node{nullptr, {}, {}, false, &marker});
+    endPush();
+    marker.done.wait(false, std::memory_order_acquire);
+
+    return marker.isWritten;
+}
+
+void CyberlibsCore::OutputSink::Shutdown()
+{
+    // Pushes already past the check finish first, so nothing lands in the queue after the flusher drained it.
+    closed_.store(true);
+    for (uint32_t pushing = pushing_.load(); pushing != 0; pushing = pushing_.load())
+    {
+        pushing_.wait(pushing);
+    }
+
+    std::lock_guard<std::mutex> lock(startMutex_);
+    if (!running_.load())
+    {
+        return;
+    }
+
+    // The flusher drains the queue before it sees the stop request.
+    stopping_.store(true);
+    signal_.fetch_add(1, std::memory_order_release);
+    signal_.notify_all();
+    flusher_.join();
+
+    for (auto& [key, target] : targets_)
+    {
+        closeTarget(target);
+    }
+
+    targets_.clear();
+
+    stopping_.store(false);
+    running_.store(false, std::memory_order_release);
+}
+
+// Private Helpers
+
+bool CyberlibsCore::OutputSink::beginPush()
+{
+    pushing_.fetch_add(1);
+    if (closed_.load())
+    {
+        endPush();
+        return false;
+    }
+
+    return true;
+}
+
+void CyberlibsCore::OutputSink::endPush()
+{
+    pushing_.fetch_sub(1);
+    pushing_.notify_all();
+}
+
+void CyberlibsCore::OutputSink::push(Node* node)
+{
+    Node* head = head_.load(std::memory_order_relaxed);
+    do
+    {
+        node->next = head;
+    } while (!head_.compare_exchange_weak(head, node, std::memory_order_release, std::memory_order_relaxed));
+
+    // Only the push onto an empty queue has to wake the flusher; later ones ride along in the same batch.
+    if (!head)
+    {
+        signal_.fetch_add(1, std::memory_order_release);
+        signal_.notify_one();
+    }
+}
+
+void CyberlibsCore::OutputSink::ensureStarted()
+{
+    if (running_.load(std::memory_order_acquire))
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(startMutex_);
+    if (!running_.load())
+    {
+        flusher_ = std::thread(run);
+        running_.store(true, std::memory_order_release);
+    }
+}
+
+void CyberlibsCore::OutputSink::run()
+{
+    while (true)
+    {
+        uint32_t seen = signal_.load(std::memory_order_acquire);
+        Node* batch = head_.exchange(nullptr, std::memory_order_acq_rel);
+        if (batch)
+        {
+            writeBatch(batch);
+            continue;
+        }
+
+        if (stopping_.load())
+        {
+            break;
+        }
+
+        signal_.wait(seen, std::memory_order_acquire);
+    }
+}
+
+void CyberlibsCore::OutputSink::writeBatch(Node* batch)
+{
+    // The queue is a stack; reverse it to get the append order back.
+    Node* ordered = nullptr;
+    while (batch)
+    {
+        Node* next = batch->next;
+        batch->next = ordered;
+        ordered = batch;
+        batch = next;
+    }
+
+    std::vector<Marker*> markers;
+    for (Node* node = ordered; node;)
+    {
+        if (node->marker)
+        {
+            markers.push_back(node->marker);
+        }
+        else
+        {
+            auto [it, inserted] = targets_.try_emplace(DirectoryScanner::FoldCase(node->path.wstring()));
+            Target& target = it->second;
+            if (inserted)
+            {
+                target.path = node->path;
+                target.file = INVALID_HANDLE_VALUE;
+                target.size = 0;
+                target.replace = false;
+            }
+
+            // An overwrite makes everything queued for the file before it irrelevant.
+            if (node->replace || target.pending.empty())
+            {
+                target.pending = std::move(node->content);
+                target.replace = target.replace || node->replace;
+            }
+            else
+            {
+                target.pending += node->content;
+            }
+        }
+
+        Node* next = node->next;
+        delete node;
+        node = next;
+    }
+
+    // Content left over from a failed write goes out again with this batch.
+    bool isWritten = true;
+    for (auto& [key, target] : targets_)
+    {
+        if ((!target.pending.empty() || target.replace) && !writeTarget(target))
+        {
+            isWritten = false;
+        }
+    }
+
+    if (targets_.size() > MAX_OPEN_FILES)
+    {
+        // Files still waiting for a retry keep their pending content.
+        for (auto it = targets_.begin(); it != targets_.end();)
+        {
+            if (!it->second.pending.empty() || it->second.replace)
+            {
+                ++it;
+                continue;
+            }
+
+            closeTarget(it->second);
+            it = targets_.erase(it);
+        }
+    }
+
+    for (Marker* marker : markers)
+    {
+        marker->isWritten = isWritten;
+        marker->done.store(true, std::memory_order_release);
+        marker->done.notify_all();
+    }
+}
+
+bool CyberlibsCore::OutputSink::writeTarget(Target& target)
+{
+    // Failed content stays pending for the next batch. Appends that keep failing are capped, oldest lines first.
+    auto keepPending = [&target](size_t written) -> bool
+    {
+        target.pending.erase(0, written);
+        if (!target.replace && target.pending.size() > MAX_PENDING_SIZE)
+        {
+            size_t cut = target.pending.find('\n', target.pending.size() - MAX_PENDING_SIZE);
+            target.pending.erase(0, cut == std::string::npos ? target.pending.size() : cut + 1);
+        }
+
+        return false;
+    };
+
+    if (target.replace)
+    {
+        closeTarget(target);
+    }
+
+    if (target.file == INVALID_HANDLE_VALUE && !openTarget(target))
+    {
+        return keepPending(0);
+    }
+
+    if (!target.replace && target.size != 0 && target.size + target.pending.size() > MAX_FILE_SIZE)
+    {
+        closeTarget(target);
+        MoveFileExW(target.path.c_str(), rotatedPath(target.path).c_str(), MOVEFILE_REPLACE_EXISTING);
+        if (!openTarget(target))
+        {
+            return keepPending(0);
+        }
+    }
+
+    size_t written = 0;
+    while (written < target.pending.size())
+    {
+        DWORD chunk = static_cast<DWORD>((std::min<size_t>)(target.pending.size() - written, 1u << 30));
+        DWORD bytesWritten = 0;
+        if (!WriteFile(target.file, target.pending.data() + written, chunk, &bytesWritten, NULL))
+        {
+            // Reopened on the next batch, in case the file was removed or locked in the meantime. A partly written
+            // overwrite is simply written again from the start.
+            closeTarget(target);
+            return keepPending(target.replace ? 0 : written);
+        }
+
+        written += bytesWritten;
+    }
+
+    target.size += written;
+    target.pending.clear();
+    if (target.replace)
+    {
+        // The overwrite handle writes at its file pointer; appends reopen with FILE_APPEND_DATA.
+        closeTarget(target);
+        target.replace = false;
+    }
+
+    return true;
+}
+
+bool CyberlibsCore::OutputSink::openTarget(Target& target)
+{
+    std::error_code ec;
+    std::filesystem::create_directories(target.path.parent_path(), ec);
+
+    target.file = CreateFileW(target.path.c_str(), target.replace ? GENERIC_WRITE : FILE_APPEND_DATA,
+                              FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, NULL,
+                              target.replace ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (target.file == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    LARGE_INTEGER fileSize;
+    target.size = GetFileSizeEx(target.file, &fileSize) ? static_cast<uint64_t>(fileSize.QuadPart) : 0;
+
+    return true;
+}
+
+void CyberlibsCore::OutputSink::closeTarget(Target& target)
+{
+    if (target.file != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(target.file);
+        target.file = INVALID_HANDLE_VALUE;
+    }
+}
+
+std::filesystem::path CyberlibsCore::OutputSink::rotatedPath(const std::filesystem::path& path)
+{
+    std::filesystem::path rotated = path;
+    rotated.replace_filename(path.stem().wstring() + L".1" + path.extension().wstring());
+
+    return rotated;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <windows.h>
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace CyberlibsCore
+{
+// Appends to output files from a background thread. Callers only push onto a lock-free queue; the flusher takes
+// everything queued so far in one swap, merges it per file and issues one write per file through a handle that stays
+// open between batches. A file that would grow past MAX_FILE_SIZE is rotated to "<name>.1<ext>" first. Overwrites go
+// through the same queue, so they land in order with the appends around them.
+class OutputSink
+{
+public:
+    static constexpr uint64_t MAX_FILE_SIZE = 5 * 1024 * 1024;
+    // Idle handles beyond this are closed.
+    static constexpr size_t MAX_OPEN_FILES = 32;
+    // Content a file that cannot be written keeps for the next attempt; anything older is dropped.
+    static constexpr size_t MAX_PENDING_SIZE = 8 * 1024 * 1024;
+
+    // Both return false once Shutdown has begun; the content is not queued then.
+    static bool Append(const std::filesystem::path& path, std::string content);
+    // Replaces the whole file with content, after every append queued before it.
+    static bool Replace(const std::filesystem::path& path, std::string content);
+    // Returns once everything queued before the call was written or failed. False if some of it could not be
+    // written; it stays queued and is retried with the next batch.
+    static bool Flush();
+    static void Shutdown();
+
+private:
+    struct Marker
+    {
+        std::atomic<bool> done{false};
+        bool isWritten = true;
+    };
+
+    struct Node
+    {
+        Node* next;
+        std::filesystem::path path;
+        std::string content;
+        bool replace;
+        // Set for Flush markers, which carry no content.
+        Marker* marker;
+    };
+
+    struct Target
+    {
+        std::filesystem::path path;
+        HANDLE file;
+        uint64_t size;
+        std::string pending;
+        // The next write truncates the file instead of appending.
+        bool replace;
+    };
+
+    // Every push happens between these two, so Shutdown can wait for pushes already past the check.
+    static bool beginPush();
+    static void endPush();
+    static void push(Node* node);
+    static void ensureStarted();
+    static void run();
+    static void writeBatch(Node* batch);
+    static bool writeTarget(Target& target);
+    static bool openTarget(Target& target);
+    static void closeTarget(Target& target);
+    static std::filesystem::path rotatedPath(const std::filesystem::path& path);
+
+    static inline std::atomic<Node*> head_{nullptr};
+    static inline std::atomic<uint32_t> signal_{0};
+    static inline std::atomic<bool> running_{false};
+    static inline std::atomic<bool> stopping_{false};
+    static inline std::atomic<bool> closed_{false};
+    static inline std::atomic<uint32_t> pushing_{0};
+    static inline std::mutex startMutex_;
+    static inline std::thread flusher_;
+    // Only touched by the flusher, and by Shutdown once it has stopped.
+    static inline std::unordered_map<std::wstring, Target> targets_;
+};
+} // namespace CyberlibsCore
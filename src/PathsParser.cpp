@@ -0,0 +1,94 @@
+#include "PathsParser.hpp"
+#include "TextEncoding.hpp"
+
+#include <cstring>
+#include <span>
+
+bool CyberlibsCore::PathsParser::Parse(std::string_view text, std::vector<Record>& records)
+{
+    records.clear();
+
+    const char* data = text.data();
+    size_t size = text.size();
+    size_t position = 0;
+    uint32_t lineNumber = 0;
+
+    if (size >= 3 && std::memcmp(data, "\xEF\xBB\xBF", 3) == 0)
+    {
+        position = 3;
+    }
+
+    // Validating the whole buffer up front lets the line split below run on plain memchr.
+    if (!TextEncoding::IsValidUtf8(text.substr(position)))
+    {
+        return false;
+    }
+
+    while (position < size)
+    {
+        const char* newline = static_cast<const char*>(std::memchr(data + position, '\n', size - position));
+        size_t lineEnd = newline ? static_cast<size_t>(newline - data) : size;
+
+        parseLine(std::string_view(data + position, lineEnd - position), ++lineNumber, records);
+        position = newline ? lineEnd + 1 : size;
+    }
+
+    return true;
+}
+
+// Private Helpers
+
+std::string_view CyberlibsCore::PathsParser::trim(std::string_view text)
+{
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string_view::npos)
+    {
+        return std::string_view();
+    }
+
+    size_t end = text.find_last_not_of(" \t\r");
+
+    return text.substr(start, end - start + 1);
+}
+
+void CyberlibsCore::PathsParser::parseLine(std::string_view line, uint32_t lineNumber, std::vector<Record>& records)
+{
+    line = trim(line);
+    if (line.empty() || line[0] == '#')
+    {
+        return;
+    }
+
+    Record record{};
+    record.line = lineNumber;
+    record.shouldExist = line[0] != '!';
+    if (!record.shouldExist)
+    {
+        line = trim(line.substr(1));
+    }
+
+    size_t pipePos = line.find('|');
+    record.path = trim(line.substr(0, pipePos));
+    record.isPattern = record.path.find_first_of("*?") != std::string_view::npos;
+
+    std::string_view* literalColumns[] = {&record.hash, &record.size, &record.lastWriteTime};
+    std::string_view* patternColumns[] = {&record.count};
+    auto columns = record.isPattern ? std::span<std::string_view*>(patternColumns)
+                                    : std::span<std::string_view*>(literalColumns);
+    for (auto* column : columns)
+    {
+        if (pipePos == std::string_view::npos)
+        {
+            break;
+        }
+
+        line = line.substr(pipePos + 1);
+        pipePos = line.find('|');
+        *column = trim(line.substr(0, pipePos));
+    }
+
+    if (!record.path.empty())
+    {
+        records.push_back(record);
+    }
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Parses .paths files in a single pass over the raw bytes. Records point into the parsed buffer, which has to
+// outlive them. The parser has no Windows or game dependencies on purpose, so it can be exercised outside the game.
+//
+// Line format, columns separated by '|':
+//   [!]path [| sha256 [| size [| last write time]]]
+//   [!]pattern [| count]
+// A leading '!' means the path must not exist, or for a pattern that nothing may match it. A path containing '*' or
+// '?' is a glob pattern (see GlobPattern); both characters are invalid in Windows file names, so literal paths are
+// never mistaken for one. A pattern's count is N, N..M or N.. and defaults to "at least one". Empty lines and lines
+// starting with '#' are skipped.
+class PathsParser
+{
+public:
+    struct Record
+    {
+        std::string_view path;
+        std::string_view hash;
+        std::string_view size;
+        std::string_view lastWriteTime;
+        // Pattern records only use the count column.
+        std::string_view count;
+        bool shouldExist;
+        bool isPattern;
+        uint32_t line;
+    };
+
+    // Returns false if the buffer is not valid UTF-8; records parsed up to that point are discarded.
+    static bool Parse(std::string_view text, std::vector<Record>& records);
+
+private:
+    static std::string_view trim(std::string_view text);
+    static void parseLine(std::string_view line, uint32_t lineNumber, std::vector<Record>& records);
+};
+} // namespace CyberlibsCore
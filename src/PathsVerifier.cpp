@@ -0,0 +1,358 @@
+#include "PathsVerifier.hpp"
+#include "GameSandbox.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <unordered_map>
+
+bool CyberlibsCore::PathsVerifier::Verify(const std::filesystem::path& gameRoot,
+                                          const std::vector<PathsParser::Record>& records, const Options& options,
+                                          std::vector<Failure>* failures)
+{
+    std::vector<DirectoryGroup> groups;
+    std::unordered_map<std::wstring, size_t> groupIndices;
+    std::vector<Failure> unsafeRecords;
+    GlobSet patterns;
+    std::vector<PatternRule> patternRules;
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        if (records[i].isPattern)
+        {
+            PatternRule rule{i, 0, 0};
+            GlobPattern pattern;
+            Reason reason = Reason::UnsafePath;
+            bool isValid = pattern.Compile(records[i].path);
+            if (isValid && records[i].shouldExist)
+            {
+                isValid = parseCount(records[i].count, rule.minCount, rule.maxCount);
+                reason = Reason::InvalidPattern;
+            }
+
+            if (isValid)
+            {
+                patterns.Add(std::move(pattern), rule.maxCount);
+                patternRules.push_back(rule);
+                continue;
+            }
+
+            if (options.stopOnFirstFailure)
+            {
+                if (failures)
+                {
+                    failures->assign(1, {i, reason});
+                }
+
+                return false;
+            }
+
+            unsafeRecords.push_back({i, reason});
+            continue;
+        }
+
+        std::filesystem::path fullPath;
+        std::wstring name;
+        if (!DirectoryScanner::Resolve(gameRoot, records[i].path, fullPath, name))
+        {
+            if (options.stopOnFirstFailure)
+            {
+                if (failures)
+                {
+                    failures->assign(1, {i, Reason::UnsafePath});
+                }
+
+                return false;
+            }
+
+            unsafeRecords.push_back({i, Reason::UnsafePath});
+            continue;
+        }
+
+        std::filesystem::path directory = name.empty() ? fullPath : fullPath.parent_path();
+        auto [it, inserted] = groupIndices.try_emplace(DirectoryScanner::FoldCase(directory.wstring()), groups.size());
+        if (inserted)
+        {
+            // Checked once per directory; entries that are links themselves are checked once they are found.
+            bool isSafe = GameSandbox::ContainsDirectory(directory);
+            groups.push_back({std::move(directory), isSafe, {}, {}, {}});
+        }
+
+        groups[it->second].targets.push_back({i, std::move(fullPath), std::move(name)});
+    }
+
+    std::atomic<bool> failed{!unsafeRecords.empty()};
+    auto shouldStop = [&failed, &options]()
+    {
+        return (options.stopOnFirstFailure && failed.load(std::memory_order_relaxed)) ||
+               (options.job && options.job->IsCancelled());
+    };
+
+    WorkStealingPool::Run(groups.size(), options.maxThreads,
+                          [&](size_t index)
+                          {
+                              if (shouldStop())
+                              {
+                                  return;
+                              }
+
+                              auto& group = groups[index];
+                              if (!group.isSafe)
+                              {
+                                  for (const auto& target : group.targets)
+                                  {
+                                      group.failures.push_back({target.record, Reason::UnsafePath});
+                                  }
+
+                                  failed.store(true, std::memory_order_relaxed);
+                                  return;
+                              }
+
+                              DirectoryScanner::Listing listing;
+                              DirectoryScanner::List(group.directory, listing);
+
+                              for (const auto& target : group.targets)
+                              {
+                                  const auto& record = records[target.record];
+                                  auto entry = target.name.empty() ? listing.end() : listing.find(target.name);
+                                  if (entry != listing.end() &&
+                                      (entry->second.attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0 &&
+                                      !GameSandbox::Contains(target.path))
+                                  {
+                                      group.failures.push_back({target.record, Reason::UnsafePath});
+                                      failed.store(true, std::memory_order_relaxed);
+                                      continue;
+                                  }
+
+                                  bool exists = target.name.empty() || entry != listing.end();
+                                  if (exists != record.shouldExist)
+                                  {
+                                      group.failures.push_back(
+                                          {target.record, exists ? Reason::Unexpected : Reason::Missing});
+                                      failed.store(true, std::memory_order_relaxed);
+                                      continue;
+                                  }
+
+                                  if (!options.verifyHashes || !exists || record.hash.empty())
+                                  {
+                                      continue;
+                                  }
+
+                                  if (entry == listing.end() || entry->second.IsDirectory())
+                                  {
+                                      group.failures.push_back({target.record, Reason::TypeMismatch});
+                                      failed.store(true, std::memory_order_relaxed);
+                                      continue;
+                                  }
+
+                                  // The listing already knows the size, so a size column settles most mismatches
+                                  // without reading a byte.
+                                  uint64_t expectedSize = 0;
+                                  if (parseSize(record.size, expectedSize) && expectedSize != entry->second.size)
+                                  {
+                                      group.failures.push_back({target.record, Reason::SizeMismatch});
+                                      failed.store(true, std::memory_order_relaxed);
+                                      continue;
+                                  }
+
+                                  if (!options.sizeOnly)
+                                  {
+                                      group.candidates.push_back({target.record, target.path, entry->second.size});
+                                  }
+                              }
+
+                              if (options.job)
+                              {
+                                  options.job->AddFiles(static_cast<uint32_t>(group.targets.size()));
+                              }
+                          });
+
+    std::vector<Failure> found = std::move(unsafeRecords);
+    if (patterns.Size() != 0 && !shouldStop())
+    {
+        std::vector<uint32_t> counts;
+        patterns.Count(gameRoot, options.maxThreads, options.job, counts);
+
+        for (size_t i = 0; i < patternRules.size(); ++i)
+        {
+            if (counts[i] < patternRules[i].minCount || counts[i] > patternRules[i].maxCount)
+            {
+                found.push_back({patternRules[i].record, Reason::CountMismatch});
+                failed.store(true, std::memory_order_relaxed);
+            }
+        }
+
+        if (options.job)
+        {
+            options.job->AddFiles(static_cast<uint32_t>(patternRules.size()));
+        }
+    }
+
+    std::vector<HashCandidate> candidates;
+    uint64_t candidateBytes = 0;
+    for (auto& group : groups)
+    {
+        found.insert(found.end(), group.failures.begin(), group.failures.end());
+        for (auto& candidate : group.candidates)
+        {
+            candidateBytes += candidate.size;
+            candidates.push_back(std::move(candidate));
+        }
+    }
+
+    if (!candidates.empty() && !shouldStop())
+    {
+        // Largest files first, so one huge archive does not start last and hold up the whole pool.
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const HashCandidate& a, const HashCandidate& b) { return a.size > b.size; });
+
+        if (options.job)
+        {
+            options.job->SetTotals(candidateBytes, static_cast<uint32_t>(records.size()));
+        }
+
+        FileReader::Options readOptions;
+        readOptions.bypassCache = options.bypassCache;
+        readOptions.job = options.job;
+        // A mismatch found on one thread also stops the files still being hashed on the others.
+        readOptions.abort = options.stopOnFirstFailure ? &failed : nullptr;
+
+        std::vector<Failure> hashFailures(candidates.size(), Failure{SIZE_MAX, Reason::HashMismatch});
+
+        WorkStealingPool::Run(candidates.size(), options.maxThreads,
+                              [&](size_t index)
+                              {
+                                  if (shouldStop())
+                                  {
+                                      return;
+                                  }
+
+                                  const auto& candidate = candidates[index];
+                                  std::string hash;
+                                  auto status = FileReader::HashFile(candidate.path, readOptions, hash);
+                                  if (status == FileReader::Status::Cancelled)
+                                  {
+                                      return;
+                                  }
+
+                                  if (status != FileReader::Status::Ok)
+                                  {
+                                      hashFailures[index] = {candidate.record, Reason::Unreadable};
+                                      failed.store(true, std::memory_order_relaxed);
+                                  }
+                                  else if (!hashEquals(hash, records[candidate.record].hash))
+                                  {
+                                      hashFailures[index] = {candidate.record, Reason::HashMismatch};
+                                      failed.store(true, std::memory_order_relaxed);
+                                  }
+                              });
+
+        for (const auto& failure : hashFailures)
+        {
+            if (failure.record != SIZE_MAX)
+            {
+                found.push_back(failure);
+            }
+        }
+    }
+
+    if (failures)
+    {
+        std::sort(found.begin(), found.end(),
+                  [](const Failure& a, const Failure& b) { return a.record < b.record; });
+        *failures = std::move(found);
+    }
+
+    return !failed.load() && !(options.job && options.job->IsCancelled());
+}
+
+const char* CyberlibsCore::PathsVerifier::ToString(Reason reason)
+{
+    switch (reason)
+    {
+    case Reason::Missing:
+        return "missing";
+    case Reason::Unexpected:
+        return "unexpected";
+    case Reason::SizeMismatch:
+        return "sizeMismatch";
+    case Reason::HashMismatch:
+        return "hashMismatch";
+    case Reason::TypeMismatch:
+        return "typeMismatch";
+    case Reason::Unreadable:
+        return "unreadable";
+    case Reason::UnsafePath:
+        return "unsafePath";
+    case Reason::CountMismatch:
+        return "countMismatch";
+    case Reason::InvalidPattern:
+        return "invalidPattern";
+    }
+
+    return "unknown";
+}
+
+// Private Helpers
+
+bool CyberlibsCore::PathsVerifier::parseSize(std::string_view text, uint64_t& size)
+{
+    if (text.empty())
+    {
+        return false;
+    }
+
+    auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), size);
+
+    return error == std::errc() && end == text.data() + text.size();
+}
+
+bool CyberlibsCore::PathsVerifier::parseCount(std::string_view text, uint32_t& minCount, uint32_t& maxCount)
+{
+    if (text.empty())
+    {
+        minCount = 1;
+        maxCount = UINT32_MAX;
+        return true;
+    }
+
+    const char* end = text.data() + text.size();
+    auto [rangePos, error] = std::from_chars(text.data(), end, minCount);
+    if (error != std::errc())
+    {
+        return false;
+    }
+
+    std::string_view rest(rangePos, end - rangePos);
+    if (rest.empty())
+    {
+        maxCount = minCount;
+        return true;
+    }
+
+    if (rest.substr(0, 2) != "..")
+    {
+        return false;
+    }
+
+    rest.remove_prefix(2);
+    if (rest.empty())
+    {
+        maxCount = UINT32_MAX;
+        return true;
+    }
+
+    auto [maxEnd, maxError] = std::from_chars(rest.data(), end, maxCount);
+
+    return maxError == std::errc() && maxEnd == end && minCount <= maxCount;
+}
+
+bool CyberlibsCore::PathsVerifier::hashEquals(const std::string& actual, std::string_view expected)
+{
+    return actual.size() == expected.size() &&
+           std::equal(actual.begin(), actual.end(), expected.begin(),
+                      [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) ==
+                                                  std::tolower(static_cast<unsigned char>(b)); });
+}
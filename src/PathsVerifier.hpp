@@ -0,0 +1,102 @@
+#pragma once
+
+#include "DiagnosticsJobs.hpp"
+#include "DirectoryScanner.hpp"
+#include "FileReader.hpp"
+#include "GlobSet.hpp"
+#include "PathsParser.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Checks parsed .paths records against the game directory. Records are grouped by parent directory and every
+// directory is enumerated once, so a manifest of thousands of files costs one listing per folder instead of one
+// metadata query per line. Independent directories are scanned in parallel. Pattern records are matched together in
+// a single walk of the tree (see GlobSet).
+class PathsVerifier
+{
+public:
+    enum class Reason
+    {
+        Missing,
+        Unexpected,
+        SizeMismatch,
+        HashMismatch,
+        // The record carries a hash but names a directory.
+        TypeMismatch,
+        Unreadable,
+        // The path leaves the game directory, lexically or through a link (see GameSandbox).
+        UnsafePath,
+        CountMismatch,
+        InvalidPattern
+    };
+
+    struct Failure
+    {
+        size_t record;
+        Reason reason;
+    };
+
+    struct Options
+    {
+        uint32_t maxThreads = 1;
+        // Also hashes files whose record carries a sha256 column. Files are triaged by the size column (when
+        // present) before any hashing.
+        bool verifyHashes = false;
+        // With verifyHashes, settles the sha256 column by the size triage alone and reads no file contents, for
+        // callers on the game thread.
+        bool sizeOnly = false;
+        bool bypassCache = false;
+        // Stops all work at the first failing record. Turn off to collect every failure in one pass.
+        bool stopOnFirstFailure = true;
+        // Receives per-record progress and stops the scan once cancelled.
+        DiagnosticsJob* job = nullptr;
+    };
+
+    // Returns true when every record matches. Failures, if requested, come back ordered by record.
+    static bool Verify(const std::filesystem::path& gameRoot, const std::vector<PathsParser::Record>& records,
+                       const Options& options, std::vector<Failure>* failures = nullptr);
+    static const char* ToString(Reason reason);
+
+private:
+    struct Target
+    {
+        size_t record;
+        std::filesystem::path path;
+        std::wstring name;
+    };
+
+    struct PatternRule
+    {
+        size_t record;
+        uint32_t minCount;
+        uint32_t maxCount;
+    };
+
+    struct HashCandidate
+    {
+        size_t record;
+        std::filesystem::path path;
+        uint64_t size;
+    };
+
+    struct DirectoryGroup
+    {
+        std::filesystem::path directory;
+        bool isSafe;
+        std::vector<Target> targets;
+        std::vector<HashCandidate> candidates;
+        std::vector<Failure> failures;
+    };
+
+    static bool parseSize(std::string_view text, uint64_t& size);
+    // Parses a pattern count column: empty (at least one), N, N..M or N..
+    static bool parseCount(std::string_view text, uint32_t& minCount, uint32_t& maxCount);
+    static bool hashEquals(const std::string& actual, std::string_view expected);
+};
+} // namespace CyberlibsCore
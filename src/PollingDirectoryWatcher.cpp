@@ -0,0 +1,53 @@
+#include "PollingDirectoryWatcher.hpp"
+
+bool CyberlibsCore::PollingDirectoryWatcher::Start(const std::filesystem::path& root)
+{
+    tracked_.clear();
+    lastPoll_ = std::chrono::steady_clock::now();
+
+    return QueryLastWriteTime(root) != 0;
+}
+
+void CyberlibsCore::PollingDirectoryWatcher::Stop()
+{
+    tracked_.clear();
+}
+
+void CyberlibsCore::PollingDirectoryWatcher::Track(const std::filesystem::path& directory, uint64_t lastWriteTime)
+{
+    tracked_.insert_or_assign(directory.wstring(), std::make_pair(directory, lastWriteTime));
+}
+
+bool CyberlibsCore::PollingDirectoryWatcher::Poll(std::vector<std::filesystem::path>& changedDirectories)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now - lastPoll_ < POLL_INTERVAL)
+    {
+        return true;
+    }
+
+    lastPoll_ = now;
+    for (auto& [key, tracked] : tracked_)
+    {
+        uint64_t lastWriteTime = QueryLastWriteTime(tracked.first);
+        if (lastWriteTime != tracked.second)
+        {
+            tracked.second = lastWriteTime;
+            changedDirectories.push_back(tracked.first);
+        }
+    }
+
+    return true;
+}
+
+uint64_t CyberlibsCore::PollingDirectoryWatcher::QueryLastWriteTime(const std::filesystem::path& directory)
+{
+    WIN32_FILE_ATTRIBUTE_DATA fileInfo;
+    if (!GetFileAttributesExW(directory.c_str(), GetFileExInfoStandard, &fileInfo))
+    {
+        return 0;
+    }
+
+    return (static_cast<uint64_t>(fileInfo.ftLastWriteTime.dwHighDateTime) << 32) |
+           fileInfo.ftLastWriteTime.dwLowDateTime;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <windows.h>
+#include "DirectoryWatcher.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Fallback for volumes without change notifications (some network shares). Compares the last write time of every
+// directory the cache has listed, at most once per interval. A directory's write time only moves when entries are
+// added, removed or renamed, so in-place file edits are not noticed here; the cache re-reads listings instead.
+class PollingDirectoryWatcher : public DirectoryWatcher
+{
+public:
+    static constexpr std::chrono::milliseconds POLL_INTERVAL{1000};
+
+    bool Start(const std::filesystem::path& root) override;
+    void Stop() override;
+
+    bool ReportsFileEdits() const override
+    {
+        return false;
+    }
+
+    void Track(const std::filesystem::path& directory, uint64_t lastWriteTime) override;
+    bool Poll(std::vector<std::filesystem::path>& changedDirectories) override;
+
+    // Last write time of a directory itself, or 0 if it cannot be queried.
+    static uint64_t QueryLastWriteTime(const std::filesystem::path& directory);
+
+private:
+    std::unordered_map<std::wstring, std::pair<std::filesystem::path, uint64_t>> tracked_;
+    std::chrono::steady_clock::time_point lastPoll_{};
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,269 @@
+#include "TextEncoding.hpp"
+
+#include <emmintrin.h>
+
+#include <bit>
+#include <cstring>
+
+bool CyberlibsCore::TextEncoding::IsValidUtf8(std::string_view text)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+    const size_t size = text.size();
+
+    size_t i = 0;
+    while (i < size)
+    {
+        while (i + 64 <= size)
+        {
+            __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16));
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 32));
+            __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 48));
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d))) != 0)
+            {
+                break;
+            }
+
+            i += 64;
+        }
+
+        // Lands on the first non-ASCII byte of the block, or leaves a short tail for the byte loop.
+        while (i + 16 <= size)
+        {
+            int mask = _mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+            if (mask != 0)
+            {
+                i += std::countr_zero(static_cast<uint32_t>(mask));
+                break;
+            }
+
+            i += 16;
+        }
+
+        // Non-ASCII text tends to come in runs, so stay here until the next ASCII byte.
+        while (i < size)
+        {
+            if (data[i] < 0x80)
+            {
+                if (i + 16 <= size)
+                {
+                    break;
+                }
+
+                ++i;
+                continue;
+            }
+
+            size_t length = sequenceLength(data + i, size - i);
+            if (length == 0)
+            {
+                return false;
+            }
+
+            i += length;
+        }
+    }
+
+    return true;
+}
+
+void CyberlibsCore::TextEncoding::ReplaceInvalidUtf8(std::string& text)
+{
+    if (IsValidUtf8(text))
+    {
+        return;
+    }
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(text.data());
+    const size_t size = text.size();
+
+    std::string out;
+    out.reserve(size + size / 8);
+
+    size_t i = 0;
+    while (i < size)
+    {
+        size_t runEnd = i;
+        while (runEnd < size && data[runEnd] < 0x80)
+        {
+            ++runEnd;
+        }
+
+        out.append(text, i, runEnd - i);
+        i = runEnd;
+        if (i == size)
+        {
+            break;
+        }
+
+        size_t length = sequenceLength(data + i, size - i);
+        if (length == 0)
+        {
+            out += "\xEF\xBF\xBD";
+            ++i;
+            continue;
+        }
+
+        out.append(text, i, length);
+        i += length;
+    }
+
+    text.swap(out);
+}
+
+bool CyberlibsCore::TextEncoding::IsUtf16Le(std::string_view bytes)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    if (bytes.size() >= 2 && data[0] == 0xFF && data[1] == 0xFE)
+    {
+        return true;
+    }
+
+    return bytes.size() >= 4 && data[0] != 0 && data[0] < 0x80 && data[1] == 0 && data[2] != 0 && data[2] < 0x80 &&
+           data[3] == 0;
+}
+
+void CyberlibsCore::TextEncoding::Utf16LeToUtf8(std::string_view bytes, std::string& out)
+{
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(bytes.data());
+    size_t start = bytes.size() >= 2 && data[0] == 0xFF && data[1] == 0xFE ? 2 : 0;
+    data += start;
+    const size_t count = (bytes.size() - start) / 2;
+
+    // No unit takes more than three bytes: a surrogate pair is two units for four bytes.
+    out.resize(count * 3);
+    char* write = out.data();
+
+    const __m128i nonAscii = _mm_set1_epi16(static_cast<short>(0xFF80));
+    const __m128i zero = _mm_setzero_si128();
+
+    size_t i = 0;
+    while (i < count)
+    {
+        while (i + 8 <= count)
+        {
+            __m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i * 2));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, nonAscii), zero)) != 0xFFFF)
+            {
+                break;
+            }
+
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(write), _mm_packus_epi16(units, units));
+            write += 8;
+            i += 8;
+        }
+
+        if (i >= count)
+        {
+            break;
+        }
+
+        uint32_t unit = data[i * 2] | (static_cast<uint32_t>(data[i * 2 + 1]) << 8);
+        ++i;
+
+        if (unit >= 0xD800 && unit <= 0xDBFF && i < count)
+        {
+            uint32_t low = data[i * 2] | (static_cast<uint32_t>(data[i * 2 + 1]) << 8);
+            if (low >= 0xDC00 && low <= 0xDFFF)
+            {
+                write = encode(0x10000 + ((unit - 0xD800) << 10) + (low - 0xDC00), write);
+                ++i;
+                continue;
+            }
+        }
+
+        write = encode(unit >= 0xD800 && unit <= 0xDFFF ? 0xFFFD : unit, write);
+    }
+
+    out.resize(static_cast<size_t>(write - out.data()));
+}
+
+bool CyberlibsCore::TextEncoding::ToUtf8(std::string& content)
+{
+    if (content.size() >= 3 && std::memcmp(content.data(), "\xEF\xBB\xBF", 3) == 0)
+    {
+        content.erase(0, 3);
+    }
+    else if (IsUtf16Le(content))
+    {
+        std::string transcoded;
+        Utf16LeToUtf8(content, transcoded);
+        content.swap(transcoded);
+    }
+
+    return IsValidUtf8(content);
+}
+
+// Private Helpers
+
+size_t CyberlibsCore::TextEncoding::sequenceLength(const uint8_t* data, size_t available)
+{
+    // The valid range of the second byte depends on the lead byte; the rest are always 0x80-0xBF.
+    uint8_t lead = data[0];
+    size_t length = 0;
+    uint8_t low = 0x80;
+    uint8_t high = 0xBF;
+    if (lead >= 0xC2 && lead <= 0xDF)
+    {
+        length = 2;
+    }
+    else if (lead >= 0xE0 && lead <= 0xEF)
+    {
+        length = 3;
+        low = lead == 0xE0 ? 0xA0 : 0x80;
+        high = lead == 0xED ? 0x9F : 0xBF;
+    }
+    else if (lead >= 0xF0 && lead <= 0xF4)
+    {
+        length = 4;
+        low = lead == 0xF0 ? 0x90 : 0x80;
+        high = lead == 0xF4 ? 0x8F : 0xBF;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (available < length || data[1] < low || data[1] > high)
+    {
+        return 0;
+    }
+
+    for (size_t i = 2; i < length; ++i)
+    {
+        if ((data[i] & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+    }
+
+    return length;
+}
+
+char* CyberlibsCore::TextEncoding::encode(uint32_t codePoint, char* out)
+{
+    if (codePoint < 0x80)
+    {
+        *out++ = static_cast<char>(codePoint);
+    }
+    else if (codePoint < 0x800)
+    {
+        *out++ = static_cast<char>(0xC0 | (codePoint >> 6));
+        *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000)
+    {
+        *out++ = static_cast<char>(0xE0 | (codePoint >> 12));
+        *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+        *out++ = static_cast<char>(0xF0 | (codePoint >> 18));
+        *out++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+
+    return out;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace CyberlibsCore
+{
+// Encoding checks for text read from disk. Both directions skip through plain ASCII 64 or 8 units at a time with
+// SSE2 and only fall back to per-character work for the rare non-ASCII stretches, which is all a log usually has.
+class TextEncoding
+{
+public:
+    // Strict UTF-8: overlong forms, surrogates and code points past U+10FFFF are rejected.
+    static bool IsValidUtf8(std::string_view text);
+    // Replaces every byte that does not start a valid sequence with U+FFFD and leaves the rest untouched. Valid text
+    // is only scanned, not copied.
+    static void ReplaceInvalidUtf8(std::string& text);
+    // True with a UTF-16LE byte order mark, or without one when the text starts with two ASCII characters in
+    // UTF-16LE form, which is how the tools that write such logs leave them.
+    static bool IsUtf16Le(std::string_view bytes);
+    // Unpaired surrogates become U+FFFD and a trailing odd byte is dropped. The byte order mark is not copied.
+    static void Utf16LeToUtf8(std::string_view bytes, std::string& out);
+    // Brings file content to UTF-8 in place: a UTF-8 byte order mark is dropped and UTF-16LE is transcoded.
+    // Returns false if the result is not valid UTF-8.
+    static bool ToUtf8(std::string& content);
+
+private:
+    // Length of the valid sequence starting at data, or 0 if it is invalid or cut off.
+    static size_t sequenceLength(const uint8_t* data, size_t available);
+    static char* encode(uint32_t codePoint, char* out);
+};
+} // namespace CyberlibsCore
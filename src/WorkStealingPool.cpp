@@ -0,0 +1,124 @@
+#include "WorkStealingPool.hpp"
+#include "DiagnosticsScheduler.hpp"
+
+#include <algorithm>
+#include <exception>
+
+void CyberlibsCore::WorkStealingPool::Run(size_t taskCount, uint32_t maxThreads, const Task& task)
+{
+    if (taskCount == 0)
+    {
+        return;
+    }
+
+    size_t workerCount = (std::min)(static_cast<size_t>((std::max)(maxThreads, 1u)), taskCount);
+    std::vector<std::unique_ptr<WorkerQueue>> queues;
+    queues.reserve(workerCount);
+
+    for (size_t worker = 0; worker < workerCount; ++worker)
+    {
+        auto queue = std::make_unique<WorkerQueue>();
+        size_t first = taskCount * worker / workerCount;
+        size_t last = taskCount * (worker + 1) / workerCount;
+        for (size_t i = first; i < last; ++i)
+        {
+            queue->indices.push_back(i);
+        }
+
+        queues.push_back(std::move(queue));
+    }
+
+    auto work = [&queues, &task](size_t worker)
+    {
+        size_t index = 0;
+        while (popLocal(*queues[worker], index) || steal(queues, worker, index))
+        {
+            try
+            {
+                task(index);
+            }
+            catch (const std::exception&)
+            {
+            }
+        }
+    };
+
+    // Helpers run at the caller's priority class, so background hashing stays background on every thread.
+    auto priority = DiagnosticsScheduler::GetCurrentPriority();
+    auto helper = [&work, priority](size_t worker)
+    {
+        DiagnosticsScheduler::PriorityScope priorityScope(priority);
+        work(worker);
+    };
+
+    auto state = std::make_shared<HelperState>();
+    for (size_t worker = 1; worker < workerCount; ++worker)
+    {
+        bool queued = DiagnosticsScheduler::Help(
+            [state, &helper, worker]()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(state->mutex);
+                    if (state->closed)
+                    {
+                        return;
+                    }
+
+                    state->active++;
+                }
+
+                helper(worker);
+
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->active--;
+                state->idle.notify_all();
+            });
+
+        if (!queued)
+        {
+            break;
+        }
+    }
+
+    work(0);
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->closed = true;
+    state->idle.wait(lock, [&state]() { return state->active == 0; });
+}
+
+// Private Helpers
+
+bool CyberlibsCore::WorkStealingPool::popLocal(WorkerQueue& queue, size_t& index)
+{
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.indices.empty())
+    {
+        return false;
+    }
+
+    index = queue.indices.front();
+    queue.indices.pop_front();
+
+    return true;
+}
+
+bool CyberlibsCore::WorkStealingPool::steal(std::vector<std::unique_ptr<WorkerQueue>>& queues, size_t thief,
+                                            size_t& index)
+{
+    // Tasks are never added after Run starts, so one empty sweep over every victim means the work is done.
+    for (size_t offset = 1; offset < queues.size(); ++offset)
+    {
+        auto& victim = *queues[(thief + offset) % queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.indices.empty())
+        {
+            index = victim.indices.back();
+            victim.indices.pop_back();
+
+            return true;
+        }
+    }
+
+    return false;
+}
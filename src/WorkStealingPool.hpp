@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace CyberlibsCore
+{
+class WorkStealingPool
+{
+public:
+    using Task = std::function<void(size_t index)>;
+
+    // Runs task(0..taskCount-1) on up to maxThreads threads, the calling thread included, and returns when all
+    // tasks are done. Each worker starts with a contiguous slice of indices and steals from the others once its
+    // own queue runs dry, so a few huge files don't leave the rest of the pool idle. The extra threads are borrowed
+    // from DiagnosticsScheduler's helpers; pass DiagnosticsScheduler::ThreadBudget as maxThreads. Slices whose
+    // helper is busy elsewhere are simply stolen by the threads that did start.
+    static void Run(size_t taskCount, uint32_t maxThreads, const Task& task);
+
+private:
+    // Lets Run return without waiting for helper work that never started; the helper then finds it closed.
+    struct HelperState
+    {
+        std::mutex mutex;
+        std::condition_variable idle;
+        bool closed = false;
+        uint32_t active = 0;
+    };
+
+    struct WorkerQueue
+    {
+        std::mutex mutex;
+        std::deque<size_t> indices;
+    };
+
+    static bool popLocal(WorkerQueue& queue, size_t& index);
+    static bool steal(std::vector<std::unique_ptr<WorkerQueue>>& queues, size_t thief, size_t& index);
+};
+} // namespace CyberlibsCore
@@ -0,0 +1,325 @@
+#include "ZipWriter.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr uint32_t DATA_DESCRIPTOR_SIGNATURE = 0x08074b50;
+constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t END_OF_CENTRAL_DIRECTORY_SIGNATURE = 0x06054b50;
+// 2.0, the first version with data descriptors.
+constexpr uint16_t VERSION_NEEDED = 20;
+// Bit 3: sizes and CRC follow the data. Bit 11: names are UTF-8.
+constexpr uint16_t FLAGS = (1 << 3) | (1 << 11);
+
+// Slicing-by-8 tables for the zip (reflected 0xEDB88320) polynomial: eight bytes per step instead of one.
+constexpr std::array<std::array<uint32_t, 256>, 8> makeCrcTables()
+{
+    std::array<std::array<uint32_t, 256>, 8> tables{};
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+        {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+
+        tables[0][i] = crc;
+    }
+
+    for (uint32_t i = 0; i < 256; ++i)
+    {
+        for (size_t slice = 1; slice < 8; ++slice)
+        {
+            tables[slice][i] = (tables[slice - 1][i] >> 8) ^ tables[0][tables[slice - 1][i] & 0xFF];
+        }
+    }
+
+    return tables;
+}
+
+constexpr auto CRC_TABLES = makeCrcTables();
+} // namespace
+
+CyberlibsCore::ZipWriter::~ZipWriter()
+{
+    if (file_ != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(file_);
+    }
+}
+
+bool CyberlibsCore::ZipWriter::Open(const std::filesystem::path& path)
+{
+    file_ = CreateFileW(path.c_str(), GENERIC_WRITE, 0, NULL, CREATE_ALWAYS,
+                        FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    buffer_.resize(COPY_BUFFER_SIZE);
+
+    return file_ != INVALID_HANDLE_VALUE;
+}
+
+bool CyberlibsCore::ZipWriter::AddBuffer(std::string_view name, std::string_view data)
+{
+    FILETIME now;
+    GetSystemTimeAsFileTime(&now);
+
+    CentralEntry entry;
+    if (!beginEntry(name, now, entry) || !write(data.data(), data.size()))
+    {
+        return false;
+    }
+
+    uint32_t crc = updateCrc(0, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+
+    return endEntry(entry, crc, data.size());
+}
+
+bool CyberlibsCore::ZipWriter::AddFile(std::string_view name, const std::filesystem::path& source,
+                                       DiagnosticsJob* job)
+{
+    HANDLE input = CreateFileW(source.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+                               NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (input == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    BY_HANDLE_FILE_INFORMATION info;
+    if (!GetFileInformationByHandle(input, &info))
+    {
+        CloseHandle(input);
+        return false;
+    }
+
+    uint64_t remaining = (static_cast<uint64_t>(info.nFileSizeHigh) << 32) | info.nFileSizeLow;
+    CentralEntry entry;
+    if (!beginEntry(name, info.ftLastWriteTime, entry))
+    {
+        CloseHandle(input);
+        return false;
+    }
+
+    uint32_t crc = 0;
+    uint64_t copied = 0;
+    bool isComplete = true;
+    while (remaining != 0)
+    {
+        if (job && job->IsCancelled())
+        {
+            isComplete = false;
+            break;
+        }
+
+        DWORD toRead = static_cast<DWORD>((std::min<uint64_t>)(remaining, buffer_.size()));
+        DWORD bytesRead = 0;
+        if (!ReadFile(input, buffer_.data(), toRead, &bytesRead, NULL) || bytesRead == 0)
+        {
+            // The file shrank while being copied; what was read so far is still a consistent entry.
+            break;
+        }
+
+        crc = updateCrc(crc, buffer_.data(), bytesRead);
+        if (!write(buffer_.data(), bytesRead))
+        {
+            isComplete = false;
+            break;
+        }
+
+        copied += bytesRead;
+        remaining -= bytesRead;
+        if (job)
+        {
+            job->AddBytes(bytesRead);
+        }
+    }
+
+    CloseHandle(input);
+
+    return endEntry(entry, crc, copied) && isComplete;
+}
+
+bool CyberlibsCore::ZipWriter::Close()
+{
+    if (file_ == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+
+    uint64_t directoryOffset = offset_;
+    for (const auto& entry : entries_)
+    {
+        std::string header;
+        putU32(header, CENTRAL_HEADER_SIGNATURE);
+        putU16(header, VERSION_NEEDED);
+        putU16(header, VERSION_NEEDED);
+        putU16(header, FLAGS);
+        putU16(header, 0);
+        putU16(header, entry.dosTime);
+        putU16(header, entry.dosDate);
+        putU32(header, entry.crc);
+        putU32(header, entry.size);
+        putU32(header, entry.size);
+        putU16(header, static_cast<uint16_t>(entry.name.size()));
+        putU16(header, 0);
+        putU16(header, 0);
+        putU16(header, 0);
+        putU16(header, 0);
+        putU32(header, 0);
+        putU32(header, entry.offset);
+        header += entry.name;
+        write(header.data(), header.size());
+    }
+
+    uint64_t directorySize = offset_ - directoryOffset;
+    std::string end;
+    putU32(end, END_OF_CENTRAL_DIRECTORY_SIGNATURE);
+    putU16(end, 0);
+    putU16(end, 0);
+    putU16(end, static_cast<uint16_t>(entries_.size()));
+    putU16(end, static_cast<uint16_t>(entries_.size()));
+    putU32(end, static_cast<uint32_t>(directorySize));
+    putU32(end, static_cast<uint32_t>(directoryOffset));
+    putU16(end, 0);
+    write(end.data(), end.size());
+
+    bool isValid = !failed_ && offset_ <= (std::numeric_limits<uint32_t>::max)();
+    CloseHandle(file_);
+    file_ = INVALID_HANDLE_VALUE;
+
+    return isValid;
+}
+
+// Private Helpers
+
+bool CyberlibsCore::ZipWriter::beginEntry(std::string_view name, const FILETIME& lastWriteTime, CentralEntry& entry)
+{
+    if (failed_ || entries_.size() >= (std::numeric_limits<uint16_t>::max)() ||
+        name.size() > (std::numeric_limits<uint16_t>::max)() || offset_ > (std::numeric_limits<uint32_t>::max)())
+    {
+        return false;
+    }
+
+    entry.name = std::string(name);
+    entry.offset = static_cast<uint32_t>(offset_);
+    toDosTime(lastWriteTime, entry.dosTime, entry.dosDate);
+
+    // CRC and sizes stay zero here and are given in the data descriptor instead.
+    std::string header;
+    putU32(header, LOCAL_HEADER_SIGNATURE);
+    putU16(header, VERSION_NEEDED);
+    putU16(header, FLAGS);
+    putU16(header, 0);
+    putU16(header, entry.dosTime);
+    putU16(header, entry.dosDate);
+    putU32(header, 0);
+    putU32(header, 0);
+    putU32(header, 0);
+    putU16(header, static_cast<uint16_t>(entry.name.size()));
+    putU16(header, 0);
+    header += entry.name;
+
+    return write(header.data(), header.size());
+}
+
+bool CyberlibsCore::ZipWriter::endEntry(CentralEntry& entry, uint32_t crc, uint64_t size)
+{
+    if (size > (std::numeric_limits<uint32_t>::max)())
+    {
+        failed_ = true;
+        return false;
+    }
+
+    entry.crc = crc;
+    entry.size = static_cast<uint32_t>(size);
+
+    std::string descriptor;
+    putU32(descriptor, DATA_DESCRIPTOR_SIGNATURE);
+    putU32(descriptor, entry.crc);
+    putU32(descriptor, entry.size);
+    putU32(descriptor, entry.size);
+    if (!write(descriptor.data(), descriptor.size()))
+    {
+        return false;
+    }
+
+    entries_.push_back(std::move(entry));
+
+    return true;
+}
+
+bool CyberlibsCore::ZipWriter::write(const void* data, size_t size)
+{
+    const char* bytes = static_cast<const char*>(data);
+    while (size != 0 && !failed_)
+    {
+        DWORD bytesWritten = 0;
+        DWORD chunk = static_cast<DWORD>((std::min<size_t>)(size, 1u << 30));
+        if (!WriteFile(file_, bytes, chunk, &bytesWritten, NULL))
+        {
+            failed_ = true;
+            break;
+        }
+
+        bytes += bytesWritten;
+        size -= bytesWritten;
+        offset_ += bytesWritten;
+    }
+
+    return !failed_;
+}
+
+uint32_t CyberlibsCore::ZipWriter::updateCrc(uint32_t crc, const uint8_t* data, size_t size)
+{
+    crc = ~crc;
+
+    while (size >= 8)
+    {
+        uint32_t low = crc ^ (static_cast<uint32_t>(data[0]) | static_cast<uint32_t>(data[1]) << 8 |
+                              static_cast<uint32_t>(data[2]) << 16 | static_cast<uint32_t>(data[3]) << 24);
+        uint32_t high = static_cast<uint32_t>(data[4]) | static_cast<uint32_t>(data[5]) << 8 |
+                        static_cast<uint32_t>(data[6]) << 16 | static_cast<uint32_t>(data[7]) << 24;
+        crc = CRC_TABLES[7][low & 0xFF] ^ CRC_TABLES[6][(low >> 8) & 0xFF] ^ CRC_TABLES[5][(low >> 16) & 0xFF] ^
+              CRC_TABLES[4][low >> 24] ^ CRC_TABLES[3][high & 0xFF] ^ CRC_TABLES[2][(high >> 8) & 0xFF] ^
+              CRC_TABLES[1][(high >> 16) & 0xFF] ^ CRC_TABLES[0][high >> 24];
+        data += 8;
+        size -= 8;
+    }
+
+    while (size-- != 0)
+    {
+        crc = (crc >> 8) ^ CRC_TABLES[0][(crc ^ *data++) & 0xFF];
+    }
+
+    return ~crc;
+}
+
+void CyberlibsCore::ZipWriter::toDosTime(const FILETIME& fileTime, uint16_t& dosTime, uint16_t& dosDate)
+{
+    FILETIME localTime;
+    SYSTEMTIME time;
+    if (!FileTimeToLocalFileTime(&fileTime, &localTime) || !FileTimeToSystemTime(&localTime, &time) ||
+        time.wYear < 1980)
+    {
+        // 1980-01-01 00:00, the earliest time the format can express.
+        dosTime = 0;
+        dosDate = (1 << 5) | 1;
+        return;
+    }
+
+    dosTime = static_cast<uint16_t>((time.wHour << 11) | (time.wMinute << 5) | (time.wSecond / 2));
+    dosDate = static_cast<uint16_t>(((time.wYear - 1980) << 9) | (time.wMonth << 5) | time.wDay);
+}
+
+void CyberlibsCore::ZipWriter::putU16(std::string& out, uint16_t value)
+{
+    out += static_cast<char>(value & 0xFF);
+    out += static_cast<char>(value >> 8);
+}
+
+void CyberlibsCore::ZipWriter::putU32(std::string& out, uint32_t value)
+{
+    putU16(out, static_cast<uint16_t>(value & 0xFFFF));
+    putU16(out, static_cast<uint16_t>(value >> 16));
+}
@@ -0,0 +1,66 @@
+#pragma once
+
+#include "DiagnosticsJobs.hpp"
+
+#include <windows.h>
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace CyberlibsCore
+{
+// Writes a zip archive front to back without ever seeking: every entry is stored as it is read, with its CRC and
+// sizes in a data descriptor after the data. Files are copied through one fixed buffer, so memory stays flat however
+// large the inputs are. Entries are stored uncompressed and the archive is limited to the classic (non-Zip64)
+// format: 4 GB and 65535 entries.
+class ZipWriter
+{
+public:
+    static constexpr size_t COPY_BUFFER_SIZE = 1024 * 1024;
+
+    ZipWriter() = default;
+    ~ZipWriter();
+
+    ZipWriter(const ZipWriter&) = delete;
+    ZipWriter& operator=(const ZipWriter&) = delete;
+
+    bool Open(const std::filesystem::path& path);
+    // name is the UTF-8 path inside the archive, '/' separated.
+    bool AddBuffer(std::string_view name, std::string_view data);
+    // Copies the file as it is at the time of the call; a log still being written is cut at its current size.
+    // Returns false if the file cannot be opened or the archive cannot be written, job cancellation included.
+    bool AddFile(std::string_view name, const std::filesystem::path& source, DiagnosticsJob* job = nullptr);
+    // Writes the central directory. The archive is valid only after this returns true.
+    bool Close();
+
+private:
+    struct CentralEntry
+    {
+        std::string name;
+        uint32_t crc;
+        uint32_t size;
+        uint32_t offset;
+        uint16_t dosTime;
+        uint16_t dosDate;
+    };
+
+    bool beginEntry(std::string_view name, const FILETIME& lastWriteTime, CentralEntry& entry);
+    bool endEntry(CentralEntry& entry, uint32_t crc, uint64_t size);
+    bool write(const void* data, size_t size);
+
+    static uint32_t updateCrc(uint32_t crc, const uint8_t* data, size_t size);
+    static void toDosTime(const FILETIME& fileTime, uint16_t& dosTime, uint16_t& dosDate);
+    static void putU16(std::string& out, uint16_t value);
+    static void putU32(std::string& out, uint32_t value);
+
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    uint64_t offset_ = 0;
+    bool failed_ = false;
+    std::vector<CentralEntry> entries_;
+    std::vector<uint8_t> buffer_;
+};
+} // namespace CyberlibsCore
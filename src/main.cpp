@@ -2,6 +2,11 @@
 #include <RedLib.hpp>
 #include "Cyberlibs.hpp"
 #include "CyberlibsAsyncHelper.hpp"
+#include "DiagnosticsScheduler.hpp"
+#include "DirectoryTreeCache.hpp"
+#include "GameDiagnostics.hpp"
+#include "LogFollower.hpp"
+#include "OutputSink.hpp"
 
 RED4EXT_C_EXPORT bool RED4EXT_CALL Main(RED4ext::PluginHandle aHandle, RED4ext::EMainReason aReason,
                                         const RED4ext::Sdk* aSdk)
@@ -14,10 +19,19 @@ RED4EXT_C_EXPORT bool RED4EXT_CALL Main(RED4ext::PluginHandle aHandle, RED4ext::
 
         auto rtti = RED4ext::CRTTISystem::Get();
         Red::TypeInfoRegistrar::RegisterDiscovered();
+        // Baseline for "changes since last session", captured now so a crash later still leaves one behind.
+        CyberlibsCore::GameDiagnostics::BeginInstallSession();
         break;
     }
     case RED4ext::EMainReason::Unload:
     {
+        CyberlibsCore::DiagnosticsScheduler::Shutdown();
+        CyberlibsCore::OutputSink::Shutdown();
+        // A clean exit refreshes the startup baseline with anything installed during the session; cached listings
+        // make this cheap.
+        CyberlibsCore::GameDiagnostics::SaveInstallState();
+        CyberlibsCore::DirectoryTreeCache::Shutdown();
+        CyberlibsCore::LogFollower::CloseAll();
         break;
     }
     }
@@ -0,0 +1,77 @@
+#include "PathsParser.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+// Times PathsParser::Parse over a synthetic manifest shaped like a large install: mostly ASCII literal paths with
+// hash, size and time columns, a few non-ASCII names and some patterns.
+
+using CyberlibsCore::PathsParser;
+
+namespace
+{
+std::string generate(size_t targetSize)
+{
+    std::string text = "# generated by PathsParserBench\n";
+    text.reserve(targetSize + 256);
+
+    char line[256];
+    for (size_t i = 0; text.size() < targetSize; ++i)
+    {
+        if (i % 97 == 0)
+        {
+            std::snprintf(line, sizeof(line), "archive/pc/mod/mod_%04zu/*.archive | 1..\n", i % 10000);
+        }
+        else if (i % 31 == 0)
+        {
+            std::snprintf(line, sizeof(line), "r6/scripts/m\xC3\xB3\x64_%04zu/\xE6\x96\x87\xE4\xBB\xB6_%06zu.reds\n",
+                          i % 10000, i);
+        }
+        else
+        {
+            std::snprintf(line, sizeof(line),
+                          "r6/scripts/mod_%04zu/file_%06zu.reds | %016zx%016zx%016zx%016zx | %zu | "
+                          "2024-01-01 12:00:00\n",
+                          i % 10000, i, i, i * 3, i * 7, i * 11, 1000 + i % 65536);
+        }
+
+        text += line;
+    }
+
+    return text;
+}
+} // namespace
+
+// PathsParserBench [megabytes] [iterations]
+int main(int argc, char** argv)
+{
+    size_t megabytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 64;
+    int iterations = argc > 2 ? std::atoi(argv[2]) : 10;
+
+    std::string text = generate(megabytes * 1024 * 1024);
+    std::vector<PathsParser::Record> records;
+
+    double best = 0.0;
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        if (!PathsParser::Parse(text, records))
+        {
+            std::fprintf(stderr, "PathsParserBench: the generated manifest did not parse\n");
+
+            return 1;
+        }
+
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        best = (std::max)(best, static_cast<double>(text.size()) / elapsed.count());
+    }
+
+    std::printf("PathsParserBench: %zu bytes, %zu records, best of %d: %.1f MB/s\n", text.size(), records.size(),
+                iterations, best / (1024.0 * 1024.0));
+
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include "PathsParser.hpp"
+#include "ReferenceUtf8.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Differential fuzzer for PathsParser. Every input is also parsed by a deliberately naive reference that splits the
+// text into lines and columns with plain string operations; both must agree on validity and on every record. Runs a
+// seeded random loop by default, or serves as a libFuzzer target when built with CYBERLIBS_LIBFUZZER.
+
+using CyberlibsCore::PathsParser;
+using CyberlibsTests::referenceIsValidUtf8;
+
+namespace
+{
+struct Expected
+{
+    std::string path;
+    std::string hash;
+    std::string size;
+    std::string lastWriteTime;
+    std::string count;
+    bool shouldExist;
+    bool isPattern;
+    uint32_t line;
+};
+
+std::string trim(const std::string& text)
+{
+    size_t start = text.find_first_not_of(" \t\r");
+    if (start == std::string::npos)
+    {
+        return std::string();
+    }
+
+    return text.substr(start, text.find_last_not_of(" \t\r") - start + 1);
+}
+
+bool referenceParse(std::string text, std::vector<Expected>& records)
+{
+    records.clear();
+    if (text.compare(0, 3, "\xEF\xBB\xBF") == 0)
+    {
+        text.erase(0, 3);
+    }
+
+    if (!referenceIsValidUtf8(text))
+    {
+        return false;
+    }
+
+    uint32_t lineNumber = 0;
+    size_t start = 0;
+    while (start < text.size())
+    {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos)
+        {
+            end = text.size();
+        }
+
+        std::string line = trim(text.substr(start, end - start));
+        start = end + 1;
+        ++lineNumber;
+
+        if (line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+
+        Expected record{};
+        record.line = lineNumber;
+        record.shouldExist = line[0] != '!';
+        if (!record.shouldExist)
+        {
+            line = trim(line.substr(1));
+        }
+
+        std::vector<std::string> columns;
+        size_t columnStart = 0;
+        while (true)
+        {
+            size_t pipe = line.find('|', columnStart);
+            columns.push_back(trim(line.substr(columnStart, pipe - columnStart)));
+            if (pipe == std::string::npos)
+            {
+                break;
+            }
+
+            columnStart = pipe + 1;
+        }
+
+        columns.resize(4);
+        record.path = columns[0];
+        record.isPattern = record.path.find_first_of("*?") != std::string::npos;
+        if (record.isPattern)
+        {
+            record.count = columns[1];
+        }
+        else
+        {
+            record.hash = columns[1];
+            record.size = columns[2];
+            record.lastWriteTime = columns[3];
+        }
+
+        if (!record.path.empty())
+        {
+            records.push_back(record);
+        }
+    }
+
+    return true;
+}
+
+bool isInside(std::string_view text, std::string_view view)
+{
+    return view.empty() || (view.data() >= text.data() && view.data() + view.size() <= text.data() + text.size());
+}
+
+void fail(std::string_view text, const char* reason)
+{
+    std::fprintf(stderr, "PathsParserFuzz: %s for input of %zu bytes:\n", reason, text.size());
+    for (unsigned char c : text)
+    {
+        std::fprintf(stderr, "%02x", c);
+    }
+
+    std::fprintf(stderr, "\n");
+    std::abort();
+}
+
+void check(std::string_view text)
+{
+    std::vector<PathsParser::Record> records;
+    std::vector<Expected> expected;
+    bool isValid = PathsParser::Parse(text, records);
+    if (isValid != referenceParse(std::string(text), expected))
+    {
+        fail(text, "validity differs from the reference");
+    }
+
+    if (!isValid)
+    {
+        if (!records.empty())
+        {
+            fail(text, "records left behind after a failed parse");
+        }
+
+        return;
+    }
+
+    if (records.size() != expected.size())
+    {
+        fail(text, "record count differs from the reference");
+    }
+
+    for (size_t i = 0; i < records.size(); ++i)
+    {
+        const auto& record = records[i];
+        const auto& reference = expected[i];
+        for (auto view : {record.path, record.hash, record.size, record.lastWriteTime, record.count})
+        {
+            if (!isInside(text, view))
+            {
+                fail(text, "record points outside the buffer");
+            }
+        }
+
+        if (record.path != reference.path || record.hash != reference.hash || record.size != reference.size ||
+            record.lastWriteTime != reference.lastWriteTime || record.count != reference.count ||
+            record.shouldExist != reference.shouldExist || record.isPattern != reference.isPattern ||
+            record.line != reference.line)
+        {
+            fail(text, "record differs from the reference");
+        }
+    }
+}
+
+// Builds inputs out of the pieces real .paths files are made of, plus broken UTF-8, so most inputs reach deep into
+// the parser instead of failing on the first byte.
+std::string generate(std::mt19937_64& random)
+{
+    static const char* TOKENS[] = {"r6/scripts/mod/file.reds", "archive/pc/mod/", "bin/x64/plugins/", "a", "Z", ".",
+                                   "/", "\\", "|", " | ", " ", "\t", "\r", "\n", "\r\n", "#", "!", "*", "?", "**/",
+                                   "0123456789abcdef0123456789abcdef", "1024", "1..3", "2..", "2024-01-01 12:00:00",
+                                   "\xC3\xA9", "\xE4\xB8\xAD", "\xF0\x9F\x98\x80", "\xEF\xBB\xBF", "\x80", "\xC0\xAF",
+                                   "\xC3", "\xE0\x80\x80", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xF0\x9F\x98", "\xFF"};
+    static constexpr size_t TOKEN_COUNT = sizeof(TOKENS) / sizeof(TOKENS[0]);
+
+    std::string text;
+    if (random() % 8 == 0)
+    {
+        text = "\xEF\xBB\xBF";
+    }
+
+    // Long ASCII runs exercise the vectorised skip in TextEncoding, short ones the byte loop around it.
+    size_t pieces = random() % 64;
+    for (size_t i = 0; i < pieces; ++i)
+    {
+        if (random() % 16 == 0)
+        {
+            text.append(random() % 40, static_cast<char>('a' + random() % 26));
+        }
+        else
+        {
+            text += TOKENS[random() % TOKEN_COUNT];
+        }
+    }
+
+    return text;
+}
+} // namespace
+
+#ifdef CYBERLIBS_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    check(std::string_view(reinterpret_cast<const char*>(data), size));
+
+    return 0;
+}
+#else
+// PathsParserFuzz [iterations] [seed]
+int main(int argc, char** argv)
+{
+    uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::random_device()();
+    std::mt19937_64 random(seed);
+
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        check(generate(random));
+    }
+
+    std::printf("PathsParserFuzz: %llu inputs agree with the reference (seed %llu)\n",
+                static_cast<unsigned long long>(iterations), static_cast<unsigned long long>(seed));
+
+    return 0;
+}
+#endif
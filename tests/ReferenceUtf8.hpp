@@ -0,0 +1,82 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Naive UTF-8 validation shared by the differential tests: one code point at a time, rejecting overlong forms,
+// surrogates and anything above U+10FFFF.
+
+namespace CyberlibsTests
+{
+// Length of the valid sequence at text[i], or 0 if it is invalid or cut off.
+inline size_t referenceSequenceLength(std::string_view text, size_t i)
+{
+    uint8_t lead = static_cast<uint8_t>(text[i]);
+    uint32_t codePoint = 0;
+    size_t length = 0;
+    if (lead < 0x80)
+    {
+        return 1;
+    }
+    else if ((lead & 0xE0) == 0xC0)
+    {
+        codePoint = lead & 0x1F;
+        length = 2;
+    }
+    else if ((lead & 0xF0) == 0xE0)
+    {
+        codePoint = lead & 0x0F;
+        length = 3;
+    }
+    else if ((lead & 0xF8) == 0xF0)
+    {
+        codePoint = lead & 0x07;
+        length = 4;
+    }
+    else
+    {
+        return 0;
+    }
+
+    if (i + length > text.size())
+    {
+        return 0;
+    }
+
+    for (size_t j = 1; j < length; ++j)
+    {
+        uint8_t byte = static_cast<uint8_t>(text[i + j]);
+        if ((byte & 0xC0) != 0x80)
+        {
+            return 0;
+        }
+
+        codePoint = (codePoint << 6) | (byte & 0x3F);
+    }
+
+    static constexpr uint32_t MIN_CODE_POINT[] = {0, 0, 0x80, 0x800, 0x10000};
+    if (codePoint < MIN_CODE_POINT[length] || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+    {
+        return 0;
+    }
+
+    return length;
+}
+
+inline bool referenceIsValidUtf8(std::string_view text)
+{
+    for (size_t i = 0; i < text.size();)
+    {
+        size_t length = referenceSequenceLength(text, i);
+        if (length == 0)
+        {
+            return false;
+        }
+
+        i += length;
+    }
+
+    return true;
+}
+} // namespace CyberlibsTests
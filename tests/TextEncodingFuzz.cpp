@@ -0,0 +1,327 @@
+#include "ReferenceUtf8.hpp"
+#include "TextEncoding.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <string_view>
+
+// Known-answer and differential tests for TextEncoding. The SSE2 paths are compared against a deliberately naive
+// reference that decodes one code point at a time; both must agree on UTF-8 validity, on the replacement of invalid
+// bytes and on UTF-16LE transcoding. Runs the known answers and then a seeded random loop by default, or serves as a
+// libFuzzer target when built with CYBERLIBS_LIBFUZZER.
+
+using CyberlibsCore::TextEncoding;
+using CyberlibsTests::referenceIsValidUtf8;
+using CyberlibsTests::referenceSequenceLength;
+
+namespace
+{
+std::string referenceReplaceInvalidUtf8(std::string_view text)
+{
+    std::string out;
+    for (size_t i = 0; i < text.size();)
+    {
+        size_t length = referenceSequenceLength(text, i);
+        if (length == 0)
+        {
+            out += "\xEF\xBF\xBD";
+            ++i;
+            continue;
+        }
+
+        out.append(text, i, length);
+        i += length;
+    }
+
+    return out;
+}
+
+void referenceEncode(uint32_t codePoint, std::string& out)
+{
+    if (codePoint < 0x80)
+    {
+        out += static_cast<char>(codePoint);
+    }
+    else if (codePoint < 0x800)
+    {
+        out += static_cast<char>(0xC0 | (codePoint >> 6));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else if (codePoint < 0x10000)
+    {
+        out += static_cast<char>(0xE0 | (codePoint >> 12));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    else
+    {
+        out += static_cast<char>(0xF0 | (codePoint >> 18));
+        out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+}
+
+std::string referenceUtf16LeToUtf8(std::string_view bytes)
+{
+    if (bytes.size() >= 2 && bytes[0] == '\xFF' && bytes[1] == '\xFE')
+    {
+        bytes.remove_prefix(2);
+    }
+
+    auto unitAt = [bytes](size_t index)
+    {
+        return static_cast<uint8_t>(bytes[index * 2]) |
+               (static_cast<uint32_t>(static_cast<uint8_t>(bytes[index * 2 + 1])) << 8);
+    };
+
+    std::string out;
+    size_t count = bytes.size() / 2;
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t unit = unitAt(i);
+        if (unit >= 0xD800 && unit <= 0xDBFF && i + 1 < count && unitAt(i + 1) >= 0xDC00 && unitAt(i + 1) <= 0xDFFF)
+        {
+            referenceEncode(0x10000 + ((unit - 0xD800) << 10) + (unitAt(i + 1) - 0xDC00), out);
+            ++i;
+        }
+        else
+        {
+            referenceEncode(unit >= 0xD800 && unit <= 0xDFFF ? 0xFFFD : unit, out);
+        }
+    }
+
+    return out;
+}
+
+void fail(std::string_view text, const char* reason)
+{
+    std::fprintf(stderr, "TextEncodingFuzz: %s for input of %zu bytes:\n", reason, text.size());
+    for (unsigned char c : text)
+    {
+        std::fprintf(stderr, "%02x", c);
+    }
+
+    std::fprintf(stderr, "\n");
+    std::abort();
+}
+
+void check(std::string_view text)
+{
+    bool isValid = TextEncoding::IsValidUtf8(text);
+    if (isValid != referenceIsValidUtf8(text))
+    {
+        fail(text, "UTF-8 validity differs from the reference");
+    }
+
+    std::string replaced(text);
+    TextEncoding::ReplaceInvalidUtf8(replaced);
+    if (replaced != referenceReplaceInvalidUtf8(text) || !TextEncoding::IsValidUtf8(replaced))
+    {
+        fail(text, "replacement differs from the reference");
+    }
+
+    std::string transcoded;
+    TextEncoding::Utf16LeToUtf8(text, transcoded);
+    if (transcoded != referenceUtf16LeToUtf8(text) || !TextEncoding::IsValidUtf8(transcoded))
+    {
+        fail(text, "UTF-16LE transcoding differs from the reference");
+    }
+}
+
+void checkKnownAnswers()
+{
+    struct Utf8Case
+    {
+        std::string_view text;
+        bool isValid;
+    };
+
+    // Boundaries of every sequence length, then each way a sequence can be rejected.
+    static constexpr Utf8Case UTF8_CASES[] = {
+        {"", true},
+        {"plain ascii", true},
+        {"\x7F", true},
+        {"\xC2\x80", true},
+        {"\xDF\xBF", true},
+        {"\xE0\xA0\x80", true},
+        {"\xED\x9F\xBF", true},
+        {"\xEE\x80\x80", true},
+        {"\xEF\xBF\xBF", true},
+        {"\xF0\x90\x80\x80", true},
+        {"\xF4\x8F\xBF\xBF", true},
+        {"\x80", false},
+        {"\xBF", false},
+        {"\xC0\x80", false},
+        {"\xC1\xBF", false},
+        {"\xE0\x9F\xBF", false},
+        {"\xED\xA0\x80", false},
+        {"\xED\xBF\xBF", false},
+        {"\xF0\x8F\xBF\xBF", false},
+        {"\xF4\x90\x80\x80", false},
+        {"\xF5\x80\x80\x80", false},
+        {"\xFF", false},
+        {"\xC3", false},
+        {"\xE4\xB8", false},
+        {"\xF0\x9F\x98", false},
+        {"\xC3\x28", false},
+        {"\xE4\x28\xAD", false},
+    };
+
+    for (const auto& testCase : UTF8_CASES)
+    {
+        if (TextEncoding::IsValidUtf8(testCase.text) != testCase.isValid)
+        {
+            fail(testCase.text, "known UTF-8 answer is wrong");
+        }
+    }
+
+    // An invalid byte on either side of each block boundary the vector loops use.
+    for (size_t position : {0, 15, 16, 17, 63, 64, 65, 127, 128})
+    {
+        std::string text(192, 'a');
+        text[position] = '\x80';
+        if (TextEncoding::IsValidUtf8(text))
+        {
+            fail(text, "invalid byte after an ASCII run was missed");
+        }
+
+        // A valid sequence cut off by the end of the buffer.
+        text.assign(position, 'a');
+        text += "\xE4\xB8";
+        if (TextEncoding::IsValidUtf8(text))
+        {
+            fail(text, "truncated sequence at the end was accepted");
+        }
+    }
+
+    struct ReplaceCase
+    {
+        std::string_view text;
+        std::string_view expected;
+    };
+
+    static constexpr ReplaceCase REPLACE_CASES[] = {
+        {"valid \xC3\xA9", "valid \xC3\xA9"},
+        {"a\x80z", "a\xEF\xBF\xBDz"},
+        {"\xC3", "\xEF\xBF\xBD"},
+        // One replacement per byte that cannot start a valid sequence.
+        {"\xE0\x80\x80", "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD"},
+        {"\xF0\x9F\x98!", "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD!"},
+        {"\xED\xA0\x80\xC3\xA9", "\xEF\xBF\xBD\xEF\xBF\xBD\xEF\xBF\xBD\xC3\xA9"},
+    };
+
+    for (const auto& testCase : REPLACE_CASES)
+    {
+        std::string text(testCase.text);
+        TextEncoding::ReplaceInvalidUtf8(text);
+        if (text != testCase.expected)
+        {
+            fail(testCase.text, "known replacement is wrong");
+        }
+    }
+
+    static constexpr ReplaceCase UTF16_CASES[] = {
+        {std::string_view("\xFF\xFE" "A\0", 4), "A"},
+        {std::string_view("h\0i\0", 4), "hi"},
+        {std::string_view("\xE9\0", 2), "\xC3\xA9"},
+        {std::string_view("\x2D\x4E", 2), "\xE4\xB8\xAD"},
+        {std::string_view("\x3D\xD8\x00\xDE", 4), "\xF0\x9F\x98\x80"},
+        {std::string_view("\x3D\xD8", 2), "\xEF\xBF\xBD"},
+        {std::string_view("\x00\xDE" "a\0", 4), "\xEF\xBF\xBD" "a"},
+        {std::string_view("a\0b", 3), "a"},
+        // Long enough for the eight-unit block, with a non-ASCII unit inside the second one.
+        {std::string_view("a\0b\0c\0d\0e\0f\0g\0h\0i\0j\0\xE9\0k\0", 24), "abcdefghij\xC3\xA9k"},
+    };
+
+    for (const auto& testCase : UTF16_CASES)
+    {
+        std::string out;
+        TextEncoding::Utf16LeToUtf8(testCase.text, out);
+        if (out != testCase.expected)
+        {
+            fail(testCase.text, "known UTF-16LE answer is wrong");
+        }
+    }
+
+    if (!TextEncoding::IsUtf16Le(std::string_view("\xFF\xFE", 2)) ||
+        !TextEncoding::IsUtf16Le(std::string_view("[\0I\0", 4)) || TextEncoding::IsUtf16Le("[INFO]"))
+    {
+        fail("", "UTF-16LE detection is wrong");
+    }
+
+    std::string content = "\xEF\xBB\xBFtext";
+    if (!TextEncoding::ToUtf8(content) || content != "text")
+    {
+        fail(content, "UTF-8 byte order mark was not dropped");
+    }
+
+    content.assign("\xFF\xFEo\0k\0", 6);
+    if (!TextEncoding::ToUtf8(content) || content != "ok")
+    {
+        fail(content, "UTF-16LE content was not transcoded");
+    }
+}
+
+// Mixes ASCII runs of every length with valid and broken sequences, so inputs cross the 16- and 64-byte blocks at
+// all offsets. Odd-length inputs and stray surrogate halves reach the UTF-16LE edge cases too.
+std::string generate(std::mt19937_64& random)
+{
+    using namespace std::string_view_literals;
+    // Literals with an explicit size, since several tokens contain NUL bytes.
+    static constexpr std::string_view TOKENS[] = {
+        "a"sv, "Z"sv, " "sv, "\n"sv, "\r\n"sv, "\t"sv, "\0"sv, "\xC3\xA9"sv, "\xE4\xB8\xAD"sv, "\xF0\x9F\x98\x80"sv,
+        "\xEF\xBB\xBF"sv, "\xFF\xFE"sv, "\x80"sv, "\xBF"sv, "\xC0\xAF"sv, "\xC3"sv, "\xE0\x80\x80"sv, "\xE0\xA0\x80"sv,
+        "\xED\x9F\xBF"sv, "\xED\xA0\x80"sv, "\xF4\x8F\xBF\xBF"sv, "\xF4\x90\x80\x80"sv, "\xF0\x9F\x98"sv, "\xF5"sv,
+        "\xFF"sv, "\x3D\xD8"sv, "\x00\xDE"sv, "\x00\xD8\x00\xDC"sv};
+    static constexpr size_t TOKEN_COUNT = sizeof(TOKENS) / sizeof(TOKENS[0]);
+
+    std::string text;
+    size_t pieces = random() % 48;
+    for (size_t i = 0; i < pieces; ++i)
+    {
+        if (random() % 4 == 0)
+        {
+            text.append(random() % 80, static_cast<char>('a' + random() % 26));
+        }
+        else
+        {
+            text += TOKENS[random() % TOKEN_COUNT];
+        }
+    }
+
+    return text;
+}
+} // namespace
+
+#ifdef CYBERLIBS_LIBFUZZER
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
+{
+    check(std::string_view(reinterpret_cast<const char*>(data), size));
+
+    return 0;
+}
+#else
+// TextEncodingFuzz [iterations] [seed]
+int main(int argc, char** argv)
+{
+    uint64_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    uint64_t seed = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::random_device()();
+    std::mt19937_64 random(seed);
+
+    checkKnownAnswers();
+
+    for (uint64_t i = 0; i < iterations; ++i)
+    {
+        check(generate(random));
+    }
+
+    std::printf("TextEncodingFuzz: known answers pass, %llu inputs agree with the reference (seed %llu)\n",
+                static_cast<unsigned long long>(iterations), static_cast<unsigned long long>(seed));
+
+    return 0;
+}
+#endif